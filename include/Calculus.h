@@ -30,6 +30,43 @@ SOFTWARE.
 #include <utility>
 #include <string>
 #include <sstream>
+#include <limits>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <cstddef>
+#include <array>
+#include <complex>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <iostream>
+#include <chrono>
+#include <cstring>
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <type_traits>
+#include <exception>
+#include <system_error>
+#include <cassert>
+
+//POSIX, for writing images straight to file descriptors. Elsewhere they go through C streams instead.
+#if defined(__unix__) || defined(__APPLE__)
+#define CALC_POSIX
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#endif
+
+//Define CALC_FLOAT128 (and link with -lquadmath) to use the algorithms with __float128 as well.
+#if defined(CALC_FLOAT128)
+#include <quadmath.h>
+#endif
 
 /**
  * @brief Namespace where everything is defined.
@@ -42,7 +79,7 @@ namespace calc
 	/**
 	 * @brief A large integer to *simulate* infinity, because I'm lazy.
 	 * 
-	 * @remarks This is the only constant that should be changed in this code.
+	 * @remarks Only the defaults of Options are derived from this, so prefer passing Options to changing it.
 	 * 
 	 */
 	const double LARGE = 10000.0;
@@ -61,412 +98,9213 @@ namespace calc
 	 */
 	const int ACCURACY = std::log10(LARGE)-1;
 
+	/**
+	 * @brief Actual infinity, for the integrals that can handle it.
+	 * 
+	 * @see integral_improper()
+	 * 
+	 */
+	const double INF = std::numeric_limits<double>::infinity();
+
+	/**
+	 * @brief Pi, since M_PI isn't standard.
+	 * 
+	 */
+	const double PI = std::acos(-1.0);
+
+	////////////////SCALARS///////////////
+
+	/*
+	Everything from derivatives to quadrature is templated on the scalar type T, defaulting to double:
+	float for cheap batch work, long double or __float128 (see CALC_FLOAT128) for reference values.
+	The library's own math goes through the detail:: functions below, so adding a scalar type only means overloading those.
+	*/
+
+	namespace detail
+	{
+		template<typename T>
+		struct Identity
+		{
+			typedef T type;
+		};
+
+		template<typename T> T abs(T x) { return std::abs(x); }
+		template<typename T> T sqrt(T x) { return std::sqrt(x); }
+		template<typename T> T cbrt(T x) { return std::cbrt(x); }
+		template<typename T> T pow(T x, typename Identity<T>::type p) { return std::pow(x, p); }
+		template<typename T> T exp(T x) { return std::exp(x); }
+		template<typename T> T log(T x) { return std::log(x); }
+		template<typename T> T sin(T x) { return std::sin(x); }
+		template<typename T> T cos(T x) { return std::cos(x); }
+		template<typename T> T tan(T x) { return std::tan(x); }
+		template<typename T> T sinh(T x) { return std::sinh(x); }
+		template<typename T> T cosh(T x) { return std::cosh(x); }
+		template<typename T> T tanh(T x) { return std::tanh(x); }
+		template<typename T> T atan(T x) { return std::atan(x); }
+		template<typename T> T acos(T x) { return std::acos(x); }
+		template<typename T> T floor(T x) { return std::floor(x); }
+		template<typename T> T ceil(T x) { return std::ceil(x); }
+		template<typename T> T ldexp(T x, int e) { return std::ldexp(x, e); }
+		template<typename T> bool isfinite(T x) { return std::isfinite(x); }
+		template<typename T> bool isinf(T x) { return std::isinf(x); }
+
+#if defined(CALC_FLOAT128)
+		//The libquadmath versions, which win over the templates as exact matches.
+		inline __float128 abs(__float128 x) { return fabsq(x); }
+		inline __float128 sqrt(__float128 x) { return sqrtq(x); }
+		inline __float128 cbrt(__float128 x) { return cbrtq(x); }
+		inline __float128 pow(__float128 x, __float128 p) { return powq(x, p); }
+		inline __float128 exp(__float128 x) { return expq(x); }
+		inline __float128 log(__float128 x) { return logq(x); }
+		inline __float128 sin(__float128 x) { return sinq(x); }
+		inline __float128 cos(__float128 x) { return cosq(x); }
+		inline __float128 tan(__float128 x) { return tanq(x); }
+		inline __float128 sinh(__float128 x) { return sinhq(x); }
+		inline __float128 cosh(__float128 x) { return coshq(x); }
+		inline __float128 tanh(__float128 x) { return tanhq(x); }
+		inline __float128 atan(__float128 x) { return atanq(x); }
+		inline __float128 acos(__float128 x) { return acosq(x); }
+		inline __float128 floor(__float128 x) { return floorq(x); }
+		inline __float128 ceil(__float128 x) { return ceilq(x); }
+		inline __float128 ldexp(__float128 x, int e) { return ldexpq(x, e); }
+		inline bool isfinite(__float128 x) { return finiteq(x); }
+		inline bool isinf(__float128 x) { return isinfq(x); }
+#endif
+
+		/**
+		 * @brief Machine epsilon of a scalar type.
+		 * 
+		 */
+		template<typename T>
+		T epsilon()
+		{
+			return std::numeric_limits<T>::epsilon();
+		}
+
+		/**
+		 * @brief Infinity in a scalar type, the templated INF.
+		 * 
+		 */
+		template<typename T>
+		T infinity()
+		{
+			return std::numeric_limits<T>::infinity();
+		}
+
+		/**
+		 * @brief Pi to the full precision of a scalar type, the templated PI.
+		 * 
+		 */
+		template<typename T>
+		T pi()
+		{
+			static const T value = acos(T(-1));
+			return value;
+		}
+
+#if defined(CALC_FLOAT128)
+		//std::numeric_limits isn't specialized for __float128.
+		template<>
+		inline __float128 epsilon<__float128>()
+		{
+			return ldexpq(1, -112);
+		}
+
+		template<>
+		inline __float128 infinity<__float128>()
+		{
+			return __builtin_huge_valq();
+		}
+#endif
+	}
+
 	////////////////TYPEDEFS///////////////
 
+	/**
+	 * @brief Stops a parameter from taking part in template argument deduction, so f(x, 1) still means T = double.
+	 * 
+	 */
+	template<typename T>
+	using NoDeduce = typename detail::Identity<T>::type;
+
+	/**
+	 * @brief A function of one variable in scalar type T. Never deduced, so lambdas can be passed straight in.
+	 * 
+	 */
+	template<typename T>
+	using BasicFunc = NoDeduce<std::function<T(T)>>;
+
 	/**
 	 * @brief For simplicity.
 	 * 
 	 */
-	typedef std::function<double(double)> Func;
+	typedef BasicFunc<double> Func;
 
-	/////////////////////////METHODS/////////////////////////////////////
+	/**
+	 * @brief An analytic function that can also be evaluated off the real line.
+	 * 
+	 */
+	typedef std::function<std::complex<double>(std::complex<double>)> CFunc;
 
 	/**
-	 * @brief Rounding function with amount of digits to round to.
+	 * @brief A function of two variables, like the right side of dy/dx = f(x, y).
+	 * 
+	 */
+	typedef std::function<double(double, double)> Func2;
+
+	/**
+	 * @brief A function of several variables, taking the point as a vector.
 	 * 
-	 * @param value The value to round.
-	 * @param places The amount of places to round to.
-	 * @return double The rounded value.
 	 */
-	constexpr double round(double value, unsigned places)
+	typedef std::function<double(const std::vector<double>&)> FuncN;
+
+	/**
+	 * @brief A batched FuncN: takes count points packed one after another, and writes count values.
+	 * 
+	 */
+	typedef std::function<void(const std::vector<double> &points, std::vector<double> &values)> BatchFuncN;
+
+	/**
+	 * @brief Which entries of a Jacobian can be nonzero: for each row i, the columns j where df_i/dy_j might not be 0.
+	 * 
+	 * @remarks Empty means every entry can be.
+	 * 
+	 */
+	typedef std::vector<std::vector<std::size_t>> Sparsity;
+
+	/**
+	 * @brief A numerical result, along with how far it should be trusted.
+	 * 
+	 */
+	template<typename T>
+	struct BasicEstimate
 	{
-		int prod = std::pow(10, places);
-		return std::floor(value * prod + 0.5) / prod;
-	}
+		/**
+		 * @brief The approximated value.
+		 * 
+		 */
+		T value;
+
+		/**
+		 * @brief Estimate of the absolute error in value.
+		 * 
+		 */
+		T error;
+
+		/**
+		 * @brief How many times the function was evaluated to get here.
+		 * 
+		 */
+		std::size_t evaluations;
+	};
+
+	typedef BasicEstimate<double> Estimate;
 
 	/**
-	 * @brief Returns the derivative of a function as a callable function.
+	 * @brief The finite difference schemes derivative() and derivative_estimate() can use.
 	 * 
-	 * @param fx The function to take the derivative of.
-	 * @return Func The derivative.
 	 */
-	Func derivative(Func fx)
+	enum class DiffScheme
 	{
-		return [&](double x)->double{
-			return round(
-				(fx(x+SMALL)-fx(x))*LARGE,
-				ACCURACY
-			);
-		};
-	}
+		/**
+		 * @brief (f(x+h) - f(x)) / h with a fixed step, which is what derivative() always used. 2 evaluations, about 4 digits.
+		 * 
+		 */
+		Forward,
+
+		/**
+		 * @brief (f(x+h) - f(x-h)) / 2h. 2 evaluations, about 10 digits.
+		 * 
+		 */
+		Central,
+
+		/**
+		 * @brief Five-point stencil. 4 evaluations, about 12 digits.
+		 * 
+		 */
+		FivePoint,
+
+		/**
+		 * @brief Ridders' Richardson extrapolation of central differences. Usually 12-14 digits in at most 20 evaluations,
+		 * 		though up to 80 if the first step turns out too coarse.
+		 * 
+		 */
+		Richardson
+	};
 
 	/**
-	 * @brief Calculates the definite integral of a function.
+	 * @brief The ways integral_definite() can integrate.
 	 * 
-	 * @param fx The function to take the definite integral of.
-	 * @param lower The lower bound.
-	 * @param upper The upper bound.
-	 * @return double The indefinite integral.
 	 */
-	double integral_definite(Func fx, double lower, double upper)
+	enum class Quadrature
 	{
-		double ret = 0;
-		for(double i = lower; i <= std::abs(upper); i+=SMALL)
-		{
-			ret += fx(i)*SMALL;
-		}
-		int sign = (upper < 0)?(-1):(1);
-		return round(ret*sign, ACCURACY);
-	}
+		/**
+		 * @brief A Riemann sum with a fixed step, which is what integral_definite() always used.
+		 * 
+		 */
+		Riemann,
+
+		/**
+		 * @brief Adaptive double-exponential quadrature, which also takes INF bounds.
+		 * 
+		 * @see integral_improper()
+		 * 
+		 */
+		TanhSinh
+	};
 
 	/**
-	 * @brief Returns the indefinite integral of a function as a callable lambda.
+	 * @brief The explicit Runge-Kutta methods the ODE solvers can step with.
 	 * 
-	 * @param fx The lambda/function to integrate.
-	 * @param valid_value A value within the function's domain.
-	 * @return Func The integral of the function.
+	 * @see OdeStepper
 	 * 
-	 * @remarks Changing valid_value will change the results of the integral by a constant.
-	 * 		The indefinite integral is calculated as the integral from valid_value to X of the function.
 	 */
-	Func integral(Func fx, double valid_value = 0)
+	enum class RungeKutta
 	{
-		return [=](double x)->double{
-			return integral_definite(fx, valid_value, x);
-		};
-	}
+		/**
+		 * @brief The classic fourth order method with a fixed step. 4 evaluations a step, no error estimate,
+		 * 		and cubic Hermite interpolation in between.
+		 * 
+		 */
+		RK4,
+
+		/**
+		 * @brief Dormand & Prince's 5(4) pair: fifth order steps, sized by the difference from the embedded fourth order solution,
+		 * 		with fourth order interpolation in between. 6 evaluations a step, since its last one is the next step's first.
+		 * 
+		 */
+		DormandPrince,
+
+		/**
+		 * @brief Verner's 6(5) pair, as DVERK has it: sixth order steps, sized by the difference from the embedded fifth order solution,
+		 * 		with fifth order interpolation. 8 evaluations a step, plus 1 for every step that's interpolated.
+		 * 		The interpolant's coefficients are long doubles, so __float128 solutions in between steps stop improving around 1e-19.
+		 * 
+		 */
+		Verner65,
+
+		/**
+		 * @brief Prince & Dormand's 8(7) pair, RK8(7)13M: eighth order steps, sized by the difference from the embedded seventh order solution,
+		 * 		with seventh order interpolation. 13 evaluations a step, plus 5 for every step that's interpolated.
+		 * 		Its coefficients are long doubles, so __float128 solutions stop improving around 1e-18.
+		 * 
+		 */
+		PrinceDormand87,
+
+		/**
+		 * @brief Hairer's DOP853: eighth order steps, sized by embedded fifth and third order estimates, with seventh order interpolation.
+		 * 		12 evaluations a step, plus 3 for every step that's interpolated. Pays off for tolerances below 1e-7 or so.
+		 * 		Its coefficients are long doubles, so __float128 solutions stop improving around 1e-19.
+		 * 
+		 */
+		DOP853
+	};
 
 	/**
-	 * @brief Uses Newton's method to approximate the roots of a function.
+	 * @brief The implicit methods the stiff ODE solvers can step with.
 	 * 
-	 * @param fx The function to calculate the roots of.
-	 * @param initial The initial value. The closer it is to the root, the less iterations required to reach it.
-	 * @param iter The amount of iterations to do.
-	 * @return double The approximation of the nearest root.
+	 * @see StiffStepper
+	 * 
+	 */
+	enum class Stiff
+	{
+		/**
+		 * @brief Rang & Angermann's ROS34PW2: a third order Rosenbrock method, with an embedded second order estimate.
+		 * 		4 evaluations and a factorization a step. L-stable, and still third order with an inexact Jacobian,
+		 * 		or on stiff problems driven by t, where Rodas4 loses order. Good for loose tolerances.
+		 * 		Its coefficients are only given to 17 digits, so long double solutions stop improving there.
+		 * 
+		 */
+		ROS34PW2,
+
+		/**
+		 * @brief Hairer & Wanner's RODAS: a fourth order Rosenbrock method, with an embedded third order estimate.
+		 * 		6 evaluations and a factorization a step, and stable however stiff the problem gets.
+		 * 		Its coefficients are only given to 16 digits, so long double solutions stop improving there.
+		 * 
+		 */
+		Rodas4,
+
+		/**
+		 * @brief Backward differentiation formulas of orders 1 to 5, picking the order and step as it goes,
+		 * 		in the modified (NDF) form of MATLAB's ode15s. Each step is a few Newton iterations,
+		 * 		and the Jacobian and its factorization are kept for as many steps as they still converge.
+		 * 		Usually the cheapest for large systems and tight tolerances.
+		 * 
+		 */
+		BDF
+	};
+
+	/**
+	 * @brief Accuracy vs. speed policy, taken by every algorithm as its last argument.
+	 * 
+	 * @remarks The defaults reproduce the old global behaviour of derivative(), integral() and roots(),
+	 * 		driven by LARGE, SMALL and ACCURACY. Use Options::precise() or Options::fast() as a starting point otherwise.
+	 * 		The tolerances scale with the precision of T, so the same presets make sense for float and long double.
+	 * 
+	 */
+	template<typename T>
+	struct BasicOptions
+	{
+		/**
+		 * @brief Relative error target of the adaptive algorithms.
+		 * 
+		 */
+		T rel_tol = detail::sqrt(detail::epsilon<T>());
+
+		/**
+		 * @brief Absolute error target of the adaptive algorithms. Whichever target is looser wins.
+		 * 
+		 */
+		T abs_tol = 0;
+
+		/**
+		 * @brief Budget of function evaluations (or series terms) for the adaptive algorithms.
+		 * 
+		 */
+		std::size_t max_evaluations = 1000000;
+
+		/**
+		 * @brief Finest refinement level of the double-exponential rules. Each level doubles their evaluations.
+		 * 
+		 */
+		unsigned max_level = 10;
+
+		/**
+		 * @brief The step of the fixed-step strategies, DiffScheme::Forward, Quadrature::Riemann and RungeKutta::RK4.
+		 * 
+		 */
+		T step = T(SMALL);
+
+		/**
+		 * @brief How derivative() and roots() differentiate.
+		 * 
+		 */
+		DiffScheme diff = DiffScheme::Forward;
+
+		/**
+		 * @brief How integral_definite() and integral() integrate.
+		 * 
+		 */
+		Quadrature quadrature = Quadrature::Riemann;
+
+		/**
+		 * @brief How the ODE solvers step.
+		 * 
+		 */
+		RungeKutta ode = RungeKutta::DormandPrince;
+
+		/**
+		 * @brief How the stiff ODE solvers step.
+		 * 
+		 */
+		Stiff stiff = Stiff::Rodas4;
+
+		/**
+		 * @brief Digits derivative() and integral_definite() round their results to, or negative for no rounding.
+		 * 
+		 */
+		int digits = ACCURACY;
+
+		/**
+		 * @brief Threads for integral_cubature(), integral_qmc() and ode_solve_batch(), or 0 for one per hardware thread.
+		 * 
+		 * @remarks 1 by default, so the functions they're given are only called from several threads at once when asked for.
+		 * 
+		 */
+		unsigned threads = 1;
+
+		/**
+		 * @brief Full precision: Richardson derivatives, tanh-sinh integrals, DOP853 steps, tight tolerances and no rounding.
+		 * 
+		 */
+		static BasicOptions precise()
+		{
+			BasicOptions opts;
+			//1e-13 for doubles.
+			opts.rel_tol = 450 * detail::epsilon<T>();
+			opts.diff = DiffScheme::Richardson;
+			opts.quadrature = Quadrature::TanhSinh;
+			opts.ode = RungeKutta::DOP853;
+			opts.digits = -1;
+			return opts;
+		}
+
+		/**
+		 * @brief About 6 digits (or half of T's, if it has fewer) for as few evaluations as possible.
+		 * 
+		 */
+		static BasicOptions fast()
+		{
+			BasicOptions opts;
+			opts.rel_tol = std::max(T(1e-6), detail::sqrt(detail::epsilon<T>()));
+			opts.max_evaluations = 10000;
+			opts.max_level = 5;
+			opts.diff = DiffScheme::Central;
+			opts.quadrature = Quadrature::TanhSinh;
+			opts.digits = -1;
+			return opts;
+		}
+	};
+
+	typedef BasicOptions<double> Options;
+
+	/////////////////////////METHODS/////////////////////////////////////
+
+	/**
+	 * @brief Rounding function with amount of digits to round to.
 	 * 
-	 * @remarks TODO: Check if the values repeat over iterations, and save processing time by returning.
+	 * @param value The value to round.
+	 * @param places The amount of places to round to.
+	 * @return T The rounded value.
 	 */
-	double roots(Func fx, double initial = 0, unsigned iter = 100)
+	template<typename T = double>
+	constexpr T round(NoDeduce<T> value, unsigned places)
+	{
+		int prod = std::pow(10, places);
+		return detail::floor(value * prod + T(0.5)) / prod;
+	}
+
+	namespace detail
 	{
-		if(iter == 0)
+		/**
+		 * @brief Nudges a step so x+h is exactly representable, so the step in the denominator is the one actually taken.
+		 * 
+		 */
+		template<typename T>
+		T exact_step(T x, T h)
 		{
-			return initial;
+			volatile T shifted = x + h;
+			return shifted - x;
 		}
-		else
+
+		/**
+		 * @brief Rounds a result to the digits the options ask for, if any.
+		 * 
+		 */
+		template<typename T>
+		T rounded(T value, const BasicOptions<T> &opts)
 		{
-			return roots(
-				fx,
-				initial-(fx(initial)/derivative(fx)(initial)), 
-				iter-1
-			);
+			return (opts.digits < 0) ? (value) : (round<T>(value, unsigned(opts.digits)));
 		}
 	}
 
-	/**
-	 * @brief Lambert W function approximation, which is the inverse function of x*e^x
-	 * 
-	 * @param value Input.
-	 * @return double Output.
-	 */
-	double lambertW(double value)
-	{
-		return roots(
-			[=](double x)->double{
-				return x*std::exp(x)-value;
-			},
-			value,
-			150
-		);
-	}
+	/**
+	 * @brief Calculates the derivative of a function at a point, along with an error estimate.
+	 * 
+	 * @param fx The function to take the derivative of. It has to be defined on both sides of x.
+	 * @param x Where to take the derivative.
+	 * @param scheme The finite difference scheme.
+	 * @param opts The step of DiffScheme::Forward.
+	 * @return BasicEstimate<T> The derivative.
+	 * 
+	 * @remarks Apart from Forward, steps are picked from machine epsilon and the scale of x, balancing truncation against rounding error.
+	 * 		Central and FivePoint report that a-priori balance from the function values they saw, assuming the
+	 * 		function varies on the scale of max(|x|, 1); Richardson reports the a-posteriori error of its extrapolation tableau.
+	 * 
+	 */
+	template<typename T = double>
+	BasicEstimate<T> derivative_estimate(BasicFunc<T> fx, NoDeduce<T> x, DiffScheme scheme = DiffScheme::Richardson,
+										 const BasicOptions<T> &opts = BasicOptions<T>())
+	{
+		const T eps = detail::epsilon<T>();
+		const T scale = std::max(detail::abs(x), T(1));
+		BasicEstimate<T> est = {0, 0, 0};
+
+		if(scheme == DiffScheme::Forward)
+		{
+			T h = detail::exact_step(x, opts.step);
+			T f1 = fx(x + h);
+			T f0 = fx(x);
+			est.value = (f1 - f0) / h;
+			est.error = eps * (detail::abs(f1) + detail::abs(f0)) / h + (h / scale) * detail::abs(est.value);
+			est.evaluations = 2;
+			return est;
+		}
+
+		if(scheme == DiffScheme::Central)
+		{
+			T h = detail::exact_step(x, detail::cbrt(eps) * scale);
+			T fp = fx(x + h);
+			T fm = fx(x - h);
+			est.value = (fp - fm) / (2 * h);
+			//Rounding in the difference, plus truncation for a function that varies on the scale of x.
+			est.error = eps * (detail::abs(fp) + detail::abs(fm)) / h + detail::pow(h / scale, 2) * detail::abs(est.value);
+			est.evaluations = 2;
+			return est;
+		}
+		if(scheme == DiffScheme::FivePoint)
+		{
+			T h = detail::exact_step(x, detail::pow(eps, T(0.2)) * scale);
+			T fp1 = fx(x + h);
+			T fm1 = fx(x - h);
+			T fp2 = fx(x + 2 * h);
+			T fm2 = fx(x - 2 * h);
+			est.value = (fm2 - 8 * fm1 + 8 * fp1 - fp2) / (12 * h);
+			est.error = eps * (detail::abs(fm2) + 8 * detail::abs(fm1) + 8 * detail::abs(fp1) + detail::abs(fp2)) / (6 * h)
+					  + detail::pow(h / scale, 4) * detail::abs(est.value);
+			est.evaluations = 4;
+			return est;
+		}
+
+		//Ridders: shrink the step by `shrink` each row, and extrapolate each new central difference towards h = 0.
+		//If the function turns out to vary faster than the scale of x, start over from a smaller first step.
+		const int rows = 10;
+		const int attempts = 4;
+		const T shrink = T(1.4);
+		const T safe = 2;
+		est.value = NAN;
+		est.error = detail::infinity<T>();
+		T first = T(0.1) * scale;
+		for(int attempt = 0; attempt < attempts; ++attempt, first /= 16)
+		{
+			T table[rows][rows];
+			T h = detail::exact_step(x, first);
+			T value = NAN;
+			T error = detail::infinity<T>();
+			table[0][0] = (fx(x + h) - fx(x - h)) / (2 * h);
+			est.evaluations += 2;
+			for(int i = 1; i < rows; ++i)
+			{
+				h = detail::exact_step(x, h / shrink);
+				table[0][i] = (fx(x + h) - fx(x - h)) / (2 * h);
+				est.evaluations += 2;
+				T factor = shrink * shrink;
+				for(int j = 1; j <= i; ++j)
+				{
+					table[j][i] = (table[j - 1][i] * factor - table[j - 1][i - 1]) / (factor - 1);
+					factor *= shrink * shrink;
+					T current = std::max(detail::abs(table[j][i] - table[j - 1][i]),
+											  detail::abs(table[j][i] - table[j - 1][i - 1]));
+					if(current <= error)
+					{
+						error = current;
+						value = table[j][i];
+					}
+				}
+				//Rounding has taken over once the diagonal starts moving away again.
+				if(detail::abs(table[i][i] - table[i - 1][i - 1]) >= safe * error)
+				{
+					break;
+				}
+			}
+			if(detail::isfinite(value) && (!detail::isfinite(est.value) || error < est.error))
+			{
+				est.value = value;
+				est.error = error;
+			}
+			if(est.error <= detail::sqrt(eps) * detail::abs(est.value))
+			{
+				break;
+			}
+		}
+		return est;
+	}
+
+	/**
+	 * @brief Returns the derivative of a function as a callable function.
+	 * 
+	 * @param fx The function to take the derivative of.
+	 * @param opts The difference scheme, its step, and the rounding of the result.
+	 * @return BasicFunc<T> The derivative.
+	 * 
+	 * @see derivative_estimate()
+	 */
+	template<typename T = double>
+	BasicFunc<T> derivative(BasicFunc<T> fx, const BasicOptions<T> &opts = BasicOptions<T>())
+	{
+		return [=](T x)->T{
+			return detail::rounded(derivative_estimate<T>(fx, x, opts.diff, opts).value, opts);
+		};
+	}
+
+	//Defined with the rest of the quadrature below.
+	template<typename T = double>
+	BasicEstimate<T> integral_improper(BasicFunc<T> fx, NoDeduce<T> lower, NoDeduce<T> upper,
+									   const BasicOptions<T> &opts = BasicOptions<T>());
+
+	/**
+	 * @brief Calculates the definite integral of a function.
+	 * 
+	 * @param fx The function to take the definite integral of.
+	 * @param lower The lower bound.
+	 * @param upper The upper bound.
+	 * @param opts The integration method, its step or tolerances, and the rounding of the result.
+	 * @return T The indefinite integral.
+	 */
+	template<typename T = double>
+	T integral_definite(BasicFunc<T> fx, NoDeduce<T> lower, NoDeduce<T> upper, const BasicOptions<T> &opts = BasicOptions<T>())
+	{
+		if(opts.quadrature == Quadrature::TanhSinh)
+		{
+			return detail::rounded(integral_improper<T>(fx, lower, upper, opts).value, opts);
+		}
+		T ret = 0;
+		for(T i = lower; i <= detail::abs(upper); i+=opts.step)
+		{
+			ret += fx(i)*opts.step;
+		}
+		int sign = (upper < 0)?(-1):(1);
+		return detail::rounded(ret*sign, opts);
+	}
+
+	/**
+	 * @brief Returns the indefinite integral of a function as a callable lambda.
+	 * 
+	 * @param fx The lambda/function to integrate.
+	 * @param valid_value A value within the function's domain.
+	 * @param opts Passed on to integral_definite().
+	 * @return BasicFunc<T> The integral of the function.
+	 * 
+	 * @remarks Changing valid_value will change the results of the integral by a constant.
+	 * 		The indefinite integral is calculated as the integral from valid_value to X of the function.
+	 */
+	template<typename T = double>
+	BasicFunc<T> integral(BasicFunc<T> fx, NoDeduce<T> valid_value = 0, const BasicOptions<T> &opts = BasicOptions<T>())
+	{
+		return [=](T x)->T{
+			return integral_definite<T>(fx, valid_value, x, opts);
+		};
+	}
+
+	/**
+	 * @brief Uses Newton's method to approximate the roots of a function.
+	 * 
+	 * @param fx The function to calculate the roots of.
+	 * @param initial The initial value. The closer it is to the root, the less iterations required to reach it.
+	 * @param iter The most iterations to do. It stops early once the steps stop changing the value.
+	 * @param opts How the derivative is taken.
+	 * @return T The approximation of the nearest root.
+	 */
+	template<typename T = double>
+	T roots(BasicFunc<T> fx, NoDeduce<T> initial = 0, unsigned iter = 100, const BasicOptions<T> &opts = BasicOptions<T>())
+	{
+		BasicFunc<T> dfx = derivative<T>(fx, opts);
+		for(unsigned i = 0; i < iter; ++i)
+		{
+			T next = initial-(fx(initial)/dfx(initial));
+			if(next == initial || !detail::isfinite(next))
+			{
+				break;
+			}
+			initial = next;
+		}
+		return initial;
+	}
+
+	/**
+	 * @brief Complex-step derivative of an analytic function at a point, to machine precision.
+	 * 
+	 * @param fx The function, which has to be analytic and real on the real line. No abs(), conj() or branching on the real part.
+	 * @param x Where to take the derivative.
+	 * @return double The derivative.
+	 * 
+	 * @remarks f'(x) = Im f(x + ih) / h. There's no difference of nearby values, so h can be tiny and nothing cancels.
+	 * 		Costs one complex evaluation.
+	 * 
+	 */
+	inline double derivative_complex_step(CFunc fx, double x)
+	{
+		double h = 1e-20 * std::max(std::abs(x), 1.0);
+		return std::imag(fx(std::complex<double>(x, h))) / h;
+	}
+
+	/**
+	 * @brief Returns the complex-step derivative of an analytic function as a callable function.
+	 * 
+	 * @param fx The function to take the derivative of.
+	 * @return Func The derivative.
+	 * 
+	 * @see derivative_complex_step(CFunc, double)
+	 * 
+	 */
+	inline Func derivative_complex_step(CFunc fx)
+	{
+		return [=](double x)->double{
+			return derivative_complex_step(fx, x);
+		};
+	}
+
+	/**
+	 * @brief Newton's method on an analytic function, with each step's value and derivative from a single complex evaluation.
+	 * 
+	 * @param fx The function to calculate the roots of.
+	 * @param initial The initial value.
+	 * @param iter The most iterations to do. It stops early once the steps stop changing the value.
+	 * @return double The approximation of the nearest root.
+	 * 
+	 * @see roots(), derivative_complex_step()
+	 * 
+	 */
+	inline double roots_complex_step(CFunc fx, double initial = 0, unsigned iter = 100)
+	{
+		const double eps = std::numeric_limits<double>::epsilon();
+		double x = initial;
+		for(unsigned i = 0; i < iter; ++i)
+		{
+			double h = 1e-20 * std::max(std::abs(x), 1.0);
+			std::complex<double> f = fx(std::complex<double>(x, h));
+			//Re f(x + ih) = f(x) - h^2 f''(x)/2, which is f(x) to the last bit for a step this small.
+			double step = std::real(f) / (std::imag(f) / h);
+			if(std::real(f) == 0 || !std::isfinite(step))
+			{
+				break;
+			}
+			x -= step;
+			if(std::abs(step) <= 2 * eps * std::abs(x))
+			{
+				break;
+			}
+		}
+		return x;
+	}
+
+	/**
+	 * @brief Lambert W function approximation, which is the inverse function of x*e^x
+	 * 
+	 * @param value Input.
+	 * @param opts Passed on to roots().
+	 * @return T Output.
+	 */
+	template<typename T = double>
+	T lambertW(NoDeduce<T> value, const BasicOptions<T> &opts = BasicOptions<T>())
+	{
+		return roots<T>(
+			[=](T x)->T{
+				return x*detail::exp(x)-value;
+			},
+			value,
+			150,
+			opts
+		);
+	}
+
+	/**
+	 * @brief Iterate a function over a value an amount of times.
+	 * 
+	 * @param fx The function to iterate. 
+	 * @param times The amount of times to iterate.
+	 * @param value The value to iterate over.
+	 * @return T The result.
+	 */
+	template<typename T = double>
+	T iterate(BasicFunc<T> fx, double times, NoDeduce<T> value)
+	{
+		if(times <= 0)
+		{
+			return value;
+		}
+		else return fx(iterate<T>(fx, times-1, value));
+	}
+
+	/**
+	 * @brief Like iterate(), except generalized by returning a lambda for all values.
+	 * 
+	 * @param fx The function to iterate.
+	 * @param times The amount of times to iterate.
+	 * @return BasicFunc<T> A lambda composed of the iterated function.
+	 * 
+	 * @see iterate()
+	 */
+	template<typename T = double>
+	BasicFunc<T> iterated(BasicFunc<T> fx, double times)
+	{
+		return [=](T x)->T{
+			return iterate<T>(fx, times, x);
+		};
+	}
+
+	/**
+	 * @brief Returns the first solution to setting left & right equal to eachother.
+	 * 
+	 * @param left Left side of the equal sign.
+	 * @param right Right side of the equal sign.
+	 * @param opts Passed on to roots().
+	 * @return T The first found solution.
+	 */
+	template<typename T = double>
+	T solve(BasicFunc<T> left, BasicFunc<T> right, const BasicOptions<T> &opts = BasicOptions<T>())
+	{
+		return roots<T>([&](T x)->T{
+			return left(x)-right(x);
+		}, 0, 100, opts);
+	}
+
+	//////////////////////////TAYLOR-MODE AD/////////////////////////////
+
+	/**
+	 * @brief A truncated Taylor series in t, f(x + t) = c[0] + c[1] t + ... + c[N] t^N, for forward-mode differentiation to order N.
+	 * 
+	 * @remarks Write the function once as a template or generic lambda, call it with Jet<N>::variable(x),
+	 * 		and every derivative up to order N falls out of that single pass. Math functions are found by ADL,
+	 * 		so call them unqualified: `[](auto x){ using std::exp; return exp(x) * x; }`.
+	 * 		T is the type of the coefficients; the elementary functions below find its own math by ADL the same way.
+	 * 
+	 */
+	template<std::size_t N, typename T = double>
+	class Jet
+	{
+	public:
+		/**
+		 * @brief A constant, whose higher coefficients are all 0.
+		 * 
+		 */
+		Jet(T value = 0)
+			: mC{}
+		{
+			mC[0] = value;
+		}
+
+		/**
+		 * @brief The independent variable, evaluated at x.
+		 * 
+		 */
+		static Jet variable(T x)
+		{
+			Jet j(x);
+			if(N > 0)
+			{
+				j.mC[1] = 1;
+			}
+			return j;
+		}
+
+		/**
+		 * @brief The k-th Taylor coefficient, f^(k)(x) / k!.
+		 * 
+		 */
+		T operator[](std::size_t k) const
+		{
+			return mC[k];
+		}
+
+		T &operator[](std::size_t k)
+		{
+			return mC[k];
+		}
+
+		/**
+		 * @brief The value f(x).
+		 * 
+		 */
+		T value() const
+		{
+			return mC[0];
+		}
+
+		const std::array<T, N + 1> &coefficients() const
+		{
+			return mC;
+		}
+
+		Jet &operator+=(const Jet &other)
+		{
+			for(std::size_t k = 0; k <= N; ++k)
+			{
+				mC[k] += other.mC[k];
+			}
+			return *this;
+		}
+
+		Jet &operator-=(const Jet &other)
+		{
+			for(std::size_t k = 0; k <= N; ++k)
+			{
+				mC[k] -= other.mC[k];
+			}
+			return *this;
+		}
+
+		Jet &operator*=(const Jet &other)
+		{
+			//Cauchy product, from the top down so lower coefficients are still intact when read.
+			for(std::size_t k = N + 1; k-- > 0;)
+			{
+				T sum = 0;
+				for(std::size_t j = 0; j <= k; ++j)
+				{
+					sum += mC[j] * other.mC[k - j];
+				}
+				mC[k] = sum;
+			}
+			return *this;
+		}
+
+		Jet &operator/=(const Jet &other)
+		{
+			for(std::size_t k = 0; k <= N; ++k)
+			{
+				T sum = mC[k];
+				for(std::size_t j = 0; j < k; ++j)
+				{
+					sum -= mC[j] * other.mC[k - j];
+				}
+				mC[k] = sum / other.mC[0];
+			}
+			return *this;
+		}
+
+		Jet &operator+=(T value)
+		{
+			mC[0] += value;
+			return *this;
+		}
+
+		Jet &operator-=(T value)
+		{
+			mC[0] -= value;
+			return *this;
+		}
+
+		Jet &operator*=(T value)
+		{
+			for(T &c : mC)
+			{
+				c *= value;
+			}
+			return *this;
+		}
+
+		Jet &operator/=(T value)
+		{
+			for(T &c : mC)
+			{
+				c /= value;
+			}
+			return *this;
+		}
+
+	private:
+		std::array<T, N + 1> mC;
+	};
+
+	template<std::size_t N, typename T> Jet<N, T> operator+(Jet<N, T> a, const Jet<N, T> &b) { return a += b; }
+	template<std::size_t N, typename T> Jet<N, T> operator-(Jet<N, T> a, const Jet<N, T> &b) { return a -= b; }
+	template<std::size_t N, typename T> Jet<N, T> operator*(Jet<N, T> a, const Jet<N, T> &b) { return a *= b; }
+	template<std::size_t N, typename T> Jet<N, T> operator/(Jet<N, T> a, const Jet<N, T> &b) { return a /= b; }
+	template<std::size_t N, typename T> Jet<N, T> operator+(Jet<N, T> a, NoDeduce<T> b) { return a += b; }
+	template<std::size_t N, typename T> Jet<N, T> operator-(Jet<N, T> a, NoDeduce<T> b) { return a -= b; }
+	template<std::size_t N, typename T> Jet<N, T> operator*(Jet<N, T> a, NoDeduce<T> b) { return a *= b; }
+	template<std::size_t N, typename T> Jet<N, T> operator/(Jet<N, T> a, NoDeduce<T> b) { return a /= b; }
+	template<std::size_t N, typename T> Jet<N, T> operator+(NoDeduce<T> a, const Jet<N, T> &b) { return Jet<N, T>(a) += b; }
+	template<std::size_t N, typename T> Jet<N, T> operator-(NoDeduce<T> a, const Jet<N, T> &b) { return Jet<N, T>(a) -= b; }
+	template<std::size_t N, typename T> Jet<N, T> operator*(NoDeduce<T> a, Jet<N, T> b) { return b *= a; }
+	template<std::size_t N, typename T> Jet<N, T> operator/(NoDeduce<T> a, const Jet<N, T> &b) { return Jet<N, T>(a) /= b; }
+	template<std::size_t N, typename T> Jet<N, T> operator+(const Jet<N, T> &a) { return a; }
+	template<std::size_t N, typename T> Jet<N, T> operator-(Jet<N, T> a) { return a *= T(-1); }
+
+	/*
+	Comparisons only look at the value, so branchy code takes the same branch it would on plain doubles.
+	*/
+	template<std::size_t N, typename T> bool operator<(const Jet<N, T> &a, const Jet<N, T> &b) { return a.value() < b.value(); }
+	template<std::size_t N, typename T> bool operator>(const Jet<N, T> &a, const Jet<N, T> &b) { return a.value() > b.value(); }
+	template<std::size_t N, typename T> bool operator<(const Jet<N, T> &a, NoDeduce<T> b) { return a.value() < b; }
+	template<std::size_t N, typename T> bool operator>(const Jet<N, T> &a, NoDeduce<T> b) { return a.value() > b; }
+	template<std::size_t N, typename T> bool operator<(NoDeduce<T> a, const Jet<N, T> &b) { return a < b.value(); }
+	template<std::size_t N, typename T> bool operator>(NoDeduce<T> a, const Jet<N, T> &b) { return a > b.value(); }
+	template<std::size_t N, typename T> bool operator<=(const Jet<N, T> &a, const Jet<N, T> &b) { return a.value() <= b.value(); }
+	template<std::size_t N, typename T> bool operator>=(const Jet<N, T> &a, const Jet<N, T> &b) { return a.value() >= b.value(); }
+	template<std::size_t N, typename T> bool operator<=(const Jet<N, T> &a, NoDeduce<T> b) { return a.value() <= b; }
+	template<std::size_t N, typename T> bool operator>=(const Jet<N, T> &a, NoDeduce<T> b) { return a.value() >= b; }
+	template<std::size_t N, typename T> bool operator<=(NoDeduce<T> a, const Jet<N, T> &b) { return a <= b.value(); }
+	template<std::size_t N, typename T> bool operator>=(NoDeduce<T> a, const Jet<N, T> &b) { return a >= b.value(); }
+	template<std::size_t N, typename T> bool operator==(const Jet<N, T> &a, const Jet<N, T> &b) { return a.value() == b.value(); }
+	template<std::size_t N, typename T> bool operator!=(const Jet<N, T> &a, const Jet<N, T> &b) { return a.value() != b.value(); }
+	template<std::size_t N, typename T> bool operator==(const Jet<N, T> &a, NoDeduce<T> b) { return a.value() == b; }
+	template<std::size_t N, typename T> bool operator!=(const Jet<N, T> &a, NoDeduce<T> b) { return a.value() != b; }
+	template<std::size_t N, typename T> bool operator==(NoDeduce<T> a, const Jet<N, T> &b) { return a == b.value(); }
+	template<std::size_t N, typename T> bool operator!=(NoDeduce<T> a, const Jet<N, T> &b) { return a != b.value(); }
+
+	/*
+	Elementary functions. Each uses the recurrence from differentiating its defining ODE,
+	so a whole jet costs O(N^2) rather than one nested finite difference per order.
+	*/
+
+	template<std::size_t N, typename T>
+	Jet<N, T> exp(const Jet<N, T> &a)
+	{
+		using detail::exp;
+		Jet<N, T> r(exp(a[0]));
+		for(std::size_t k = 1; k <= N; ++k)
+		{
+			T sum = 0;
+			for(std::size_t j = 1; j <= k; ++j)
+			{
+				sum += j * a[j] * r[k - j];
+			}
+			r[k] = sum / k;
+		}
+		return r;
+	}
+
+	template<std::size_t N, typename T>
+	Jet<N, T> log(const Jet<N, T> &a)
+	{
+		using detail::log;
+		Jet<N, T> r(log(a[0]));
+		for(std::size_t k = 1; k <= N; ++k)
+		{
+			T sum = 0;
+			for(std::size_t j = 1; j < k; ++j)
+			{
+				sum += j * r[j] * a[k - j];
+			}
+			r[k] = (a[k] - sum / k) / a[0];
+		}
+		return r;
+	}
+
+	template<std::size_t N, typename T>
+	Jet<N, T> pow(const Jet<N, T> &a, NoDeduce<T> p)
+	{
+		using detail::pow;
+		Jet<N, T> r(pow(a[0], p));
+		for(std::size_t k = 1; k <= N; ++k)
+		{
+			T sum = 0;
+			for(std::size_t j = 1; j <= k; ++j)
+			{
+				sum += (p * j - T(k - j)) * a[j] * r[k - j];
+			}
+			r[k] = sum / (k * a[0]);
+		}
+		return r;
+	}
+
+	template<std::size_t N, typename T>
+	Jet<N, T> sqrt(const Jet<N, T> &a)
+	{
+		using detail::sqrt;
+		Jet<N, T> r(sqrt(a[0]));
+		for(std::size_t k = 1; k <= N; ++k)
+		{
+			T sum = 0;
+			for(std::size_t j = 1; j < k; ++j)
+			{
+				sum += r[j] * r[k - j];
+			}
+			r[k] = (a[k] - sum) / (2 * r[0]);
+		}
+		return r;
+	}
+
+	namespace detail
+	{
+		/**
+		 * @brief Propagates sin & cos (sign = -1) or sinh & cosh (sign = 1) together, since each one's recurrence needs the other.
+		 * 
+		 */
+		template<std::size_t N, typename T>
+		void jet_sincos(const Jet<N, T> &a, Jet<N, T> &s, Jet<N, T> &c, T sign)
+		{
+			for(std::size_t k = 1; k <= N; ++k)
+			{
+				T ss = 0;
+				T cs = 0;
+				for(std::size_t j = 1; j <= k; ++j)
+				{
+					ss += j * a[j] * c[k - j];
+					cs += j * a[j] * s[k - j];
+				}
+				s[k] = ss / k;
+				c[k] = sign * cs / k;
+			}
+		}
+	}
+
+	template<std::size_t N, typename T>
+	Jet<N, T> sin(const Jet<N, T> &a)
+	{
+		using detail::sin;
+		using detail::cos;
+		Jet<N, T> s(sin(a[0]));
+		Jet<N, T> c(cos(a[0]));
+		detail::jet_sincos(a, s, c, T(-1));
+		return s;
+	}
+
+	template<std::size_t N, typename T>
+	Jet<N, T> cos(const Jet<N, T> &a)
+	{
+		using detail::sin;
+		using detail::cos;
+		Jet<N, T> s(sin(a[0]));
+		Jet<N, T> c(cos(a[0]));
+		detail::jet_sincos(a, s, c, T(-1));
+		return c;
+	}
+
+	template<std::size_t N, typename T>
+	Jet<N, T> tan(const Jet<N, T> &a)
+	{
+		return sin(a) / cos(a);
+	}
+
+	template<std::size_t N, typename T>
+	Jet<N, T> sinh(const Jet<N, T> &a)
+	{
+		using detail::sinh;
+		using detail::cosh;
+		Jet<N, T> s(sinh(a[0]));
+		Jet<N, T> c(cosh(a[0]));
+		detail::jet_sincos(a, s, c, T(1));
+		return s;
+	}
+
+	template<std::size_t N, typename T>
+	Jet<N, T> cosh(const Jet<N, T> &a)
+	{
+		using detail::sinh;
+		using detail::cosh;
+		Jet<N, T> s(sinh(a[0]));
+		Jet<N, T> c(cosh(a[0]));
+		detail::jet_sincos(a, s, c, T(1));
+		return c;
+	}
+
+	template<std::size_t N, typename T>
+	Jet<N, T> tanh(const Jet<N, T> &a)
+	{
+		return sinh(a) / cosh(a);
+	}
+
+	template<std::size_t N, typename T>
+	Jet<N, T> atan(const Jet<N, T> &a)
+	{
+		//atan' = a' / (1 + a^2)
+		using detail::atan;
+		Jet<N, T> b = T(1) + a * a;
+		Jet<N, T> r(atan(a[0]));
+		for(std::size_t k = 1; k <= N; ++k)
+		{
+			T sum = k * a[k];
+			for(std::size_t j = 1; j < k; ++j)
+			{
+				sum -= j * r[j] * b[k - j];
+			}
+			r[k] = sum / (k * b[0]);
+		}
+		return r;
+	}
+
+	template<std::size_t N, typename T>
+	Jet<N, T> abs(const Jet<N, T> &a)
+	{
+		return (a[0] < 0) ? (-a) : (a);
+	}
+
+	/**
+	 * @brief Taylor coefficients of a function around a point, in a single forward pass.
+	 * 
+	 * @tparam N The highest order.
+	 * @param fx A template/generic callable, evaluated once on Jet<N, T>.
+	 * @param x The point to expand around.
+	 * @return std::array<T, N+1> f^(k)(x) / k! for k = 0..N.
+	 * 
+	 */
+	template<std::size_t N, typename T = double, typename F>
+	std::array<T, N + 1> taylor_coefficients(F &&fx, NoDeduce<T> x)
+	{
+		Jet<N, T> result = fx(Jet<N, T>::variable(x));
+		return result.coefficients();
+	}
+
+	/**
+	 * @brief Every derivative of a function at a point up to order N, in a single forward pass.
+	 * 
+	 * @tparam N The highest order.
+	 * @param fx A template/generic callable, evaluated once on Jet<N, T>.
+	 * @param x Where to take the derivatives.
+	 * @return std::array<T, N+1> f^(k)(x) for k = 0..N.
+	 * 
+	 */
+	template<std::size_t N, typename T = double, typename F>
+	std::array<T, N + 1> derivatives(F &&fx, NoDeduce<T> x)
+	{
+		std::array<T, N + 1> c = taylor_coefficients<N, T>(fx, x);
+		T factorial = 1;
+		for(std::size_t k = 1; k <= N; ++k)
+		{
+			factorial *= k;
+			c[k] *= factorial;
+		}
+		return c;
+	}
+
+	/**
+	 * @brief The N-th derivative of a function at a point, without nesting derivative() N times.
+	 * 
+	 * @tparam N The order of the derivative.
+	 * @param fx A template/generic callable, evaluated once on Jet<N, T>.
+	 * @param x Where to take the derivative.
+	 * @return T f^(N)(x).
+	 * 
+	 */
+	template<std::size_t N, typename T = double, typename F>
+	T nth_derivative(F &&fx, NoDeduce<T> x)
+	{
+		return derivatives<N, T>(fx, x)[N];
+	}
+
+	/**
+	 * @brief Householder's method of a given order: Newton for 1, Halley for 2, and so on.
+	 * 
+	 * @tparam Order The order of the method, which converges with order Order+1.
+	 * @param fx A template/generic callable, evaluated once on Jet<Order, T> per iteration.
+	 * @param initial The initial value.
+	 * @param iter The most iterations to do. It stops early once the steps stop changing the value.
+	 * @return T The approximation of the nearest root.
+	 * 
+	 * @remarks The step is d (1/f)^(d-1) / (1/f)^(d), which is just c[d-1] / c[d] of the jet of 1/f.
+	 * 
+	 */
+	template<std::size_t Order = 2, typename T = double, typename F>
+	T roots_householder(F &&fx, NoDeduce<T> initial = 0, unsigned iter = 50)
+	{
+		static_assert(Order >= 1, "Householder's method needs an order of at least 1.");
+		const T eps = detail::epsilon<T>();
+		T x = initial;
+		for(unsigned i = 0; i < iter; ++i)
+		{
+			Jet<Order, T> f = fx(Jet<Order, T>::variable(x));
+			if(f[0] == 0)
+			{
+				break;
+			}
+			Jet<Order, T> inverse = T(1) / f;
+			T step = inverse[Order - 1] / inverse[Order];
+			if(!detail::isfinite(step))
+			{
+				break;
+			}
+			x += step;
+			if(detail::abs(step) <= 2 * eps * detail::abs(x))
+			{
+				break;
+			}
+		}
+		return x;
+	}
+
+	//////////////////////////SERIES/////////////////////////////
+
+	namespace detail
+	{
+		/**
+		 * @brief Compensated (Kahan-Babuska) summation, so long sums don't drift with their length.
+		 * 
+		 */
+		template<typename T>
+		class KahanSum
+		{
+		public:
+			void add(T value)
+			{
+				T t = mSum + value;
+				if(detail::abs(mSum) >= detail::abs(value))
+				{
+					mCompensation += (mSum - t) + value;
+				}
+				else
+				{
+					mCompensation += (value - t) + mSum;
+				}
+				mSum = t;
+			}
+
+			T sum() const
+			{
+				return mSum + mCompensation;
+			}
+
+		private:
+			T mSum = 0;
+			T mCompensation = 0;
+		};
+
+		/**
+		 * @brief Watches the terms of a series for signs that it can't converge,
+		 * 		so an acceleration that sums a divergent series to something finite isn't taken at its word.
+		 * 
+		 */
+		template<typename T>
+		class DivergenceCheck
+		{
+		public:
+			void add(T a)
+			{
+				++mCount;
+				mSum.add(a);
+				if(a != 0)
+				{
+					if(mSign != 0 && (a > 0) != (mSign > 0))
+					{
+						mLastFlip = mCount;
+					}
+					mSign = (a > 0) ? (1) : (-1);
+				}
+				mLast = detail::abs(a);
+				//|a| at the last two power of two counts, the older one from at most half as many terms ago.
+				if((mCount & (mCount - 1)) == 0)
+				{
+					mEarlier = mLater;
+					mEarlierCount = mCount / 2;
+					mLater = mLast;
+				}
+			}
+
+			/**
+			 * @brief Returns the estimate, or an infinite error if the terms so far say the series diverges.
+			 * 
+			 * @remarks It diverges if the terms have stopped shrinking, or if they've kept one sign over the last half
+			 * 		and either the estimate falls short of the partial sum, which a sum of terms of one sign can't,
+			 * 		or n |a_n| isn't shrinking after thousands of terms, the harmonic series' rate.
+			 * 		The value is then INF or -INF for terms of one sign, and NaN for the rest.
+			 * 
+			 */
+			BasicEstimate<T> check(BasicEstimate<T> est) const
+			{
+				if(mCount < 4)
+				{
+					return est;
+				}
+				const bool oneSign = mSign != 0 && mLastFlip <= mCount / 2;
+				const T partial = mSum.sum();
+				const T shortfall = mSign * (partial - est.value) - est.error - 8 * detail::epsilon<T>() * detail::abs(partial);
+				//A shift like 1/(n + 100)^2 looks like slower decay than it is until n is well past it.
+				const bool harmonic = mCount >= 4096 && mCount * mLast >= T(0.99) * mEarlierCount * mEarlier;
+				if(growing() || (oneSign && (shortfall > 0 || harmonic)))
+				{
+					est.value = (oneSign) ? (mSign * detail::infinity<T>()) : (T(NAN));
+					est.error = detail::infinity<T>();
+				}
+				return est;
+			}
+
+			/**
+			 * @brief Whether there's no point summing any further: the terms haven't shrunk in over a thousand.
+			 * 
+			 */
+			bool stalled() const
+			{
+				return mCount >= 1024 && growing();
+			}
+
+		private:
+			KahanSum<T> mSum;
+			std::size_t mCount = 0;
+			std::size_t mLastFlip = 0;
+			std::size_t mEarlierCount = 0;
+			int mSign = 0;
+			T mLast = 0;
+			T mEarlier = 0;
+			T mLater = 0;
+
+			bool growing() const
+			{
+				return mLast > 0 && mLast >= mEarlier;
+			}
+		};
+
+		/**
+		 * @brief Richardson extrapolation of a sequence of values at steps h_i towards h = 0, through Neville's tableau.
+		 * 
+		 */
+		template<typename T>
+		class NevilleExtrapolator
+		{
+		public:
+			/**
+			 * @brief Adds the value at the next, smaller, step, and returns the new extrapolated estimate.
+			 * 
+			 * @remarks The error is the distance to the best estimate of the previous row.
+			 * 
+			 */
+			BasicEstimate<T> add(T h, T value)
+			{
+				std::vector<T> row(mSteps.size() + 1);
+				row[0] = value;
+				mSteps.push_back(h);
+				const std::size_t i = mSteps.size() - 1;
+				for(std::size_t j = 1; j <= i; ++j)
+				{
+					T older = mSteps[i - j];
+					row[j] = (h * mRow[j - 1] - older * row[j - 1]) / (h - older);
+				}
+				BasicEstimate<T> est = {row[i], detail::infinity<T>(), 0};
+				if(i > 0)
+				{
+					est.error = detail::abs(row[i] - mRow[i - 1]);
+				}
+				mRow = row;
+				return est;
+			}
+
+		private:
+			std::vector<T> mSteps;
+			std::vector<T> mRow;
+		};
+
+		/**
+		 * @brief Wynn's epsilon algorithm over a sequence, which generalizes Shanks' transformation to every order at once.
+		 * 
+		 */
+		template<typename T>
+		class WynnEpsilon
+		{
+		public:
+			/**
+			 * @brief Adds the next element of the sequence, and returns the new accelerated estimate.
+			 * 
+			 * @remarks Only the newest ascending anti-diagonal of the epsilon table is kept; its highest even column is the estimate.
+			 * 		The error compares that with the estimates from the last two elements.
+			 * 
+			 */
+			BasicEstimate<T> add(T value)
+			{
+				const std::size_t limit = 50;
+				std::vector<T> diagonal(1, value);
+				for(std::size_t k = 1; k <= mDiagonal.size() && k < limit; ++k)
+				{
+					T before = (k >= 2) ? (mDiagonal[k - 2]) : (0);
+					T difference = diagonal[k - 1] - mDiagonal[k - 1];
+					//Two equal neighbours means the column has converged; going further would divide by zero.
+					if(difference == 0 || !detail::isfinite(difference))
+					{
+						break;
+					}
+					diagonal.push_back(before + 1 / difference);
+				}
+				mDiagonal = diagonal;
+
+				BasicEstimate<T> est = {diagonal[(diagonal.size() - 1) & ~std::size_t(1)], detail::infinity<T>(), 0};
+				if(mHistory.size() >= 2)
+				{
+					est.error = std::max(detail::abs(est.value - mHistory[mHistory.size() - 1]),
+										 detail::abs(est.value - mHistory[mHistory.size() - 2]));
+				}
+				mHistory.push_back(est.value);
+				return est;
+			}
+
+		private:
+			std::vector<T> mDiagonal;
+			std::vector<T> mHistory;
+		};
+	}
+
+	/**
+	 * @brief A polynomial in (x - center), such as a truncated Taylor series.
+	 * 
+	 */
+	template<typename T>
+	class BasicPolynomial
+	{
+	public:
+		/**
+		 * @brief Constructor.
+		 * 
+		 * @param coefficients The coefficients, constant term first.
+		 * @param center The point the polynomial is expanded around.
+		 */
+		BasicPolynomial(std::vector<T> coefficients = std::vector<T>(1, T(0)), T center = 0)
+			: mCoefficients(coefficients), mCenter(center)
+		{
+			if(mCoefficients.empty())
+			{
+				mCoefficients.push_back(0);
+			}
+		}
+
+		/**
+		 * @brief Evaluates the polynomial with Estrin's scheme.
+		 * 
+		 * @remarks Estrin splits the polynomial in halves using x^2, x^4, ..., so the two halves of every level
+		 * 		can be evaluated in parallel by the CPU, instead of Horner's single chain of dependent multiply-adds.
+		 * 
+		 */
+		T operator()(T x) const
+		{
+			T squares[64];
+			squares[0] = x - mCenter;
+			for(unsigned i = 1; i < 64 && (std::size_t(1) << i) < mCoefficients.size(); ++i)
+			{
+				squares[i] = squares[i - 1] * squares[i - 1];
+			}
+			return estrin(mCoefficients.data(), mCoefficients.size(), squares);
+		}
+
+		/**
+		 * @brief Evaluates the polynomial with Horner's scheme, which has the smallest rounding error of the two.
+		 * 
+		 */
+		T horner(T x) const
+		{
+			T t = x - mCenter;
+			T ret = mCoefficients.back();
+			for(std::size_t k = mCoefficients.size() - 1; k-- > 0;)
+			{
+				ret = ret * t + mCoefficients[k];
+			}
+			return ret;
+		}
+
+		/**
+		 * @brief Evaluates the polynomial at many points at once.
+		 * 
+		 * @param xs The points.
+		 * @param out Receives the values. Resized to match xs.
+		 * 
+		 * @remarks Horner's scheme runs coefficient by coefficient over the whole batch, so the inner loop
+		 * 		is independent per point and the compiler vectorizes it. A BasicPolynomial<float> fits twice the lanes.
+		 * 
+		 */
+		void evaluate(const std::vector<T> &xs, std::vector<T> &out) const
+		{
+			const std::size_t n = xs.size();
+			const T top = mCoefficients.back();
+			out.assign(n, top);
+			T *o = out.data();
+			const T *x = xs.data();
+			for(std::size_t k = mCoefficients.size() - 1; k-- > 0;)
+			{
+				const T c = mCoefficients[k];
+				for(std::size_t i = 0; i < n; ++i)
+				{
+					o[i] = o[i] * (x[i] - mCenter) + c;
+				}
+			}
+		}
+
+		std::size_t degree() const
+		{
+			return mCoefficients.size() - 1;
+		}
+
+		T center() const
+		{
+			return mCenter;
+		}
+
+		const std::vector<T> &coefficients() const
+		{
+			return mCoefficients;
+		}
+
+		/**
+		 * @brief Estimates the radius of convergence of the series these coefficients are the start of.
+		 * 
+		 * @return T The radius, or INF if there are too few coefficients to tell.
+		 * 
+		 * @remarks Cauchy-Hadamard: 1/R = limsup |c_k|^(1/k). The growth rate of log|c_k| is fitted by least squares over
+		 * 		the upper half of the coefficients, which is far less noisy than the last ratio.
+		 * 		Entire functions give a large radius that keeps growing with the degree.
+		 * 
+		 */
+		T radius_of_convergence() const
+		{
+			const T noise = detail::sqrt(detail::epsilon<T>());
+			T sk = 0, sl = 0, skk = 0, skl = 0;
+			int count = 0;
+			for(std::size_t k = std::max<std::size_t>(1, mCoefficients.size() / 2); k < mCoefficients.size(); ++k)
+			{
+				//Skip coefficients that are only noise next to their neighbours, like the odd ones of an even function.
+				//Below sqrt(eps) of them, which is about 1e-8 for doubles and scales with the precision of T.
+				T neighbours = detail::abs(mCoefficients[k - 1]);
+				if(k + 1 < mCoefficients.size())
+				{
+					neighbours = std::max(neighbours, detail::abs(mCoefficients[k + 1]));
+				}
+				if(mCoefficients[k] == 0 || detail::abs(mCoefficients[k]) < noise * neighbours)
+				{
+					continue;
+				}
+				T l = detail::log(detail::abs(mCoefficients[k]));
+				sk += k;
+				sl += l;
+				skk += T(k) * k;
+				skl += k * l;
+				++count;
+			}
+			if(count < 2)
+			{
+				return detail::infinity<T>();
+			}
+			T slope = (count * skl - sk * sl) / (count * skk - sk * sk);
+			return detail::exp(-slope);
+		}
+
+	private:
+		std::vector<T> mCoefficients;
+		T mCenter;
+
+		//c[0] + ... + c[n-1] t^(n-1), as the lower half plus t^half times the upper half.
+		static T estrin(const T *c, std::size_t n, const T *squares)
+		{
+			if(n == 1)
+			{
+				return c[0];
+			}
+			std::size_t half = 1;
+			unsigned level = 0;
+			while(half * 2 < n)
+			{
+				half *= 2;
+				++level;
+			}
+			return estrin(c, half, squares) + squares[level] * estrin(c + half, n - half, squares);
+		}
+	};
+
+	typedef BasicPolynomial<double> Polynomial;
+
+	/**
+	 * @brief The convergence accelerations sum_series() can use.
+	 * 
+	 */
+	enum class Acceleration
+	{
+		/**
+		 * @brief Plain compensated summation, stopping once the geometric tail estimate is small enough.
+		 * 
+		 */
+		None,
+
+		/**
+		 * @brief Extrapolates partial sums at n, 2n, 4n, ... in powers of 1/n. For series with terms like 1/n^p.
+		 * 
+		 */
+		Richardson,
+
+		/**
+		 * @brief Van Wijngaarden's form of the Euler transform. For alternating series.
+		 * 
+		 */
+		Euler,
+
+		/**
+		 * @brief Wynn's epsilon algorithm, iterated Shanks transformations. For alternating and geometric-like series.
+		 * 
+		 */
+		Wynn,
+
+		/**
+		 * @brief Levin's u transformation. Handles both alternating and logarithmically converging series.
+		 * 
+		 * @remarks Uses 40 terms at most, whatever max_evaluations is: its binomial weights lose all precision past that.
+		 * 		A series that hasn't converged by then comes back with the error of its best estimate so far.
+		 * 
+		 */
+		Levin
+	};
+
+	/**
+	 * @brief Sums an infinite series, accelerating its convergence.
+	 * 
+	 * @param term The n-th term of the series.
+	 * @param method The acceleration method.
+	 * @param start The index of the first term.
+	 * @param opts Tolerances to stop at, and the most terms to evaluate as max_evaluations.
+	 * @return BasicEstimate<T> The sum, with evaluations being the amount of terms used.
+	 * 		A series that diverges comes back with an infinite error, and INF or -INF as the value if its terms have one sign.
+	 * 
+	 * @remarks Terms are accumulated with compensated summation, so the partial sums themselves don't drift.
+	 * 		The accelerations will happily sum divergent series like 1 + 1/sqrt(2) + 1/sqrt(3) + ... to something finite,
+	 * 		so the terms are watched too: terms that stop shrinking, terms of one sign whose sum falls short of the partial sum,
+	 * 		or ones decaying no faster than 1/n after thousands of terms all mean divergence.
+	 * 
+	 */
+	template<typename T = double>
+	BasicEstimate<T> sum_series(NoDeduce<std::function<T(std::size_t)>> term, Acceleration method = Acceleration::Levin,
+								std::size_t start = 0, const BasicOptions<T> &opts = BasicOptions<T>())
+	{
+		const std::size_t max_terms = opts.max_evaluations;
+		auto converged = [&](const BasicEstimate<T> &est)->bool{
+			return est.error <= std::max(opts.abs_tol, opts.rel_tol * detail::abs(est.value));
+		};
+		BasicEstimate<T> est = {0, detail::infinity<T>(), 0};
+		detail::KahanSum<T> sum;
+		detail::DivergenceCheck<T> divergence;
+		auto watched = [&](std::size_t n)->T{
+			T a = term(n);
+			divergence.add(a);
+			return a;
+		};
+
+		if(method == Acceleration::None)
+		{
+			T previous = 0;
+			for(std::size_t n = start; est.evaluations < max_terms && !divergence.stalled(); ++n)
+			{
+				T a = watched(n);
+				++est.evaluations;
+				sum.add(a);
+				//If the terms shrink geometrically by q, what's left is about |a| q / (1 - q).
+				T q = (previous != 0) ? (detail::abs(a / previous)) : (1);
+				est.value = sum.sum();
+				est.error = (a == 0) ? (0) : ((q < 1) ? (detail::abs(a) * q / (1 - q)) : (detail::abs(a)));
+				previous = a;
+				if(est.evaluations > 2 && converged(est) && q < 1)
+				{
+					break;
+				}
+			}
+			return divergence.check(est);
+		}
+
+		if(method == Acceleration::Richardson)
+		{
+			detail::NevilleExtrapolator<T> extrapolator;
+			std::size_t n = start;
+			for(std::size_t target = 8; est.evaluations + (target - (n - start)) <= max_terms && !divergence.stalled(); target *= 2)
+			{
+				for(; n - start < target; ++n)
+				{
+					sum.add(watched(n));
+					++est.evaluations;
+				}
+				BasicEstimate<T> next = extrapolator.add(T(1) / target, sum.sum());
+				est.value = next.value;
+				est.error = next.error;
+				if(converged(est))
+				{
+					break;
+				}
+			}
+			return divergence.check(est);
+		}
+
+		if(method == Acceleration::Euler)
+		{
+			//Van Wijngaarden's workspace of averaged terms; the sum grows by whichever of its last two entries is smaller.
+			std::vector<T> work;
+			for(std::size_t n = start; est.evaluations < max_terms && !divergence.stalled(); ++n)
+			{
+				T a = watched(n);
+				++est.evaluations;
+				T increment;
+				if(work.empty())
+				{
+					work.push_back(a);
+					increment = a / 2;
+				}
+				else
+				{
+					T carry = work[0];
+					work[0] = a;
+					for(std::size_t j = 0; j + 1 < work.size(); ++j)
+					{
+						T old = work[j + 1];
+						work[j + 1] = (work[j] + carry) / 2;
+						carry = old;
+					}
+					work.push_back((work.back() + carry) / 2);
+					if(detail::abs(work.back()) <= detail::abs(work[work.size() - 2]))
+					{
+						increment = work.back() / 2;
+					}
+					else
+					{
+						increment = work.back();
+						work.pop_back();
+					}
+				}
+				sum.add(increment);
+				est.value = sum.sum();
+				est.error = detail::abs(increment);
+				if(est.evaluations > 2 && converged(est))
+				{
+					break;
+				}
+			}
+			return divergence.check(est);
+		}
+
+		if(method == Acceleration::Wynn)
+		{
+			detail::WynnEpsilon<T> epsilon;
+			for(std::size_t n = start; est.evaluations < max_terms && !divergence.stalled(); ++n)
+			{
+				sum.add(watched(n));
+				++est.evaluations;
+				BasicEstimate<T> next = epsilon.add(sum.sum());
+				est.value = next.value;
+				est.error = next.error;
+				if(converged(est))
+				{
+					break;
+				}
+			}
+			return divergence.check(est);
+		}
+
+		//Levin u: T_k = sum_j (-1)^j C(k,j) ((1+j)/(1+k))^(k-1) S_j/w_j, over the same sum with 1/w_j, where w_j = (1+j) a_j.
+		//The binomials make it unstable past ~40 terms, so the estimate with the smallest change is kept.
+		const std::size_t limit = std::min<std::size_t>(max_terms, 40);
+		std::vector<T> partial;
+		std::vector<T> remainder;
+		T previous = NAN;
+		BasicEstimate<T> best = est;
+		for(std::size_t k = 0; k < limit; ++k)
+		{
+			T a = watched(start + k);
+			++best.evaluations;
+			sum.add(a);
+			partial.push_back(sum.sum());
+			remainder.push_back(T(1 + k) * a);
+
+			T numerator = 0;
+			T denominator = 0;
+			T binomial = 1;
+			for(std::size_t j = 0; j <= k; ++j)
+			{
+				if(remainder[j] != 0)
+				{
+					T weight = binomial * detail::pow(T(1 + j) / T(1 + k), T(k) - 1) / remainder[j];
+					if(j % 2 == 1)
+					{
+						weight = -weight;
+					}
+					numerator += weight * partial[j];
+					denominator += weight;
+				}
+				binomial = binomial * (k - j) / (j + 1);
+			}
+			T value = (denominator != 0) ? (numerator / denominator) : (partial.back());
+			if(a == 0)
+			{
+				value = partial.back();
+			}
+			T error = detail::abs(value - previous);
+			previous = value;
+			if(detail::isfinite(error) && (error <= best.error || !detail::isfinite(best.value)))
+			{
+				best.value = value;
+				best.error = error;
+			}
+			if(k > 2 && converged(best))
+			{
+				break;
+			}
+		}
+		if(!detail::isfinite(best.error))
+		{
+			best.value = sum.sum();
+		}
+		return divergence.check(best);
+	}
+
+	/**
+	 * @brief Which side limit() approaches the point from.
+	 * 
+	 */
+	enum class Side
+	{
+		Both,
+		Left,
+		Right
+	};
+
+	/**
+	 * @brief Numerically evaluates a limit, at a point or at infinity.
+	 * 
+	 * @param fx The function. It's only evaluated away from the point itself.
+	 * @param point The point to approach, or INF / -INF.
+	 * @param side Which side to approach from. Both takes both one-sided limits and checks that they agree.
+	 * @param opts Tolerances to stop at, and the most evaluations a side towards infinity as max_evaluations.
+	 * @return BasicEstimate<T> The limit. The value is INF or -INF, with an infinite error, when the function grows without bound,
+	 * 		and NaN when the one-sided limits disagree.
+	 * 
+	 * @remarks The function is sampled at point +- h for h = h0, h0/2, h0/4, ... (24 times at most), or at 1, 2, 4, ... towards infinity
+	 * 		for as long as the samples keep changing. The samples are extrapolated to h = 0 both with Richardson (for limits analytic in h)
+	 * 		and Wynn's epsilon (for ones like sqrt(h) that aren't). An extrapolation's error counts how far the two are apart,
+	 * 		so it's only trusted once they agree; otherwise the last sample is, once the samples have settled.
+	 * 		Samples that keep moving the same way by at least as much every time are taken to grow without bound.
+	 * 
+	 */
+	template<typename T = double>
+	BasicEstimate<T> limit(BasicFunc<T> fx, NoDeduce<T> point, Side side = Side::Both, const BasicOptions<T> &opts = BasicOptions<T>())
+	{
+		auto target = [&](T value)->T{
+			return std::max(opts.abs_tol, opts.rel_tol * detail::abs(value));
+		};
+		if(side == Side::Both && !detail::isinf(point))
+		{
+			BasicEstimate<T> left = limit<T>(fx, point, Side::Left, opts);
+			BasicEstimate<T> right = limit<T>(fx, point, Side::Right, opts);
+			BasicEstimate<T> est = {(left.value + right.value) / 2, std::max(left.error, right.error),
+							left.evaluations + right.evaluations};
+			if(detail::isinf(left.value) || detail::isinf(right.value))
+			{
+				est.value = (left.value == right.value) ? (left.value) : (T(NAN));
+				est.error = detail::infinity<T>();
+				return est;
+			}
+			T gap = detail::abs(left.value - right.value);
+			if(gap > 10 * (left.error + right.error) + target(est.value))
+			{
+				est.value = NAN;
+			}
+			est.error = std::max(est.error, gap / 2);
+			return est;
+		}
+
+		const bool infinite = detail::isinf(point);
+		//Towards infinity, x doubles until it overflows, unless the evaluations run out first.
+		const std::size_t steps = infinite ? (opts.max_evaluations) : (24);
+		T direction = (side == Side::Left) ? (-1) : (1);
+		T h = T(0.125) * std::max(detail::abs(point), T(1));
+		if(infinite)
+		{
+			direction = (point > 0) ? (1) : (-1);
+			h = 1;
+		}
+
+		detail::NevilleExtrapolator<T> richardson;
+		detail::WynnEpsilon<T> wynn;
+		std::vector<T> samples;
+		T previous[2] = {T(NAN), T(NAN)};
+		BasicEstimate<T> best = {T(NAN), detail::infinity<T>(), 0};
+		for(std::size_t k = 0; k < steps; ++k, h /= 2)
+		{
+			T x = infinite ? (direction / h) : (point + direction * h);
+			if(x == point || !detail::isfinite(x))
+			{
+				break;
+			}
+			T value = fx(x);
+			++best.evaluations;
+			if(!detail::isfinite(value))
+			{
+				continue;
+			}
+			samples.push_back(value);
+			BasicEstimate<T> extrapolated[2] = {richardson.add(h, value), wynn.add(value)};
+			const std::size_t n = samples.size();
+			T moved[2] = {detail::abs(extrapolated[0].value - previous[0]), detail::abs(extrapolated[1].value - previous[1])};
+			previous[0] = extrapolated[0].value;
+			previous[1] = extrapolated[1].value;
+			if(n < 4)
+			{
+				continue;
+			}
+
+			//The samples themselves, with what's left if they keep closing in by the slower of the last two ratios.
+			const T step = detail::abs(samples[n - 1] - samples[n - 2]);
+			const T before = detail::abs(samples[n - 2] - samples[n - 3]);
+			const T q = std::max(step / before, before / detail::abs(samples[n - 3] - samples[n - 4]));
+			BasicEstimate<T> candidates[3] = {extrapolated[0], extrapolated[1],
+											  {samples[n - 1], (step == 0) ? (T(0)) : ((q < 1) ? (step * q / (1 - q)) : (detail::infinity<T>())), 0}};
+			const T disagreement = detail::abs(extrapolated[0].value - extrapolated[1].value);
+			for(int c = 0; c < 3; ++c)
+			{
+				BasicEstimate<T> &candidate = candidates[c];
+				if(c < 2)
+				{
+					candidate.error = std::max({candidate.error, disagreement, moved[c]});
+				}
+				if(detail::isfinite(candidate.value) && candidate.error < best.error)
+				{
+					best.value = candidate.value;
+					best.error = candidate.error;
+				}
+			}
+			//Not before there are enough samples to tell growth from convergence.
+			if(n >= 6 && best.error <= target(best.value))
+			{
+				return best;
+			}
+		}
+
+		//Out of samples without settling. Growing without bound is the last half of the steps, and at least 5,
+		//all going the same way, none shorter than the one before.
+		const std::size_t n = samples.size();
+		bool growing = n >= 6;
+		for(std::size_t i = std::min(n - 4, n / 2 + 1); growing && i < n; ++i)
+		{
+			T before = samples[i - 1] - samples[i - 2];
+			T step = samples[i] - samples[i - 1];
+			growing = before != 0 && (step > 0) == (before > 0) && detail::abs(step) >= T(0.999) * detail::abs(before);
+		}
+		if(growing)
+		{
+			best.value = (samples[n - 1] > samples[n - 2]) ? (detail::infinity<T>()) : (-detail::infinity<T>());
+			best.error = detail::infinity<T>();
+		}
+		return best;
+	}
+
+	namespace detail
+	{
+		/**
+		 * @brief In-place iterative radix-2 FFT, with the e^(-2 pi i jk/n) convention. The size must be a power of 2.
+		 * 
+		 */
+		inline void fft(std::vector<std::complex<double>> &a)
+		{
+			const std::size_t n = a.size();
+			for(std::size_t i = 1, j = 0; i < n; ++i)
+			{
+				std::size_t bit = n >> 1;
+				for(; j & bit; bit >>= 1)
+				{
+					j ^= bit;
+				}
+				j ^= bit;
+				if(i < j)
+				{
+					std::swap(a[i], a[j]);
+				}
+			}
+			for(std::size_t len = 2; len <= n; len <<= 1)
+			{
+				std::complex<double> root = std::polar(1.0, -2 * PI / len);
+				for(std::size_t i = 0; i < n; i += len)
+				{
+					std::complex<double> w(1);
+					for(std::size_t j = 0; j < len / 2; ++j)
+					{
+						std::complex<double> u = a[i + j];
+						std::complex<double> v = a[i + j + len / 2] * w;
+						a[i + j] = u + v;
+						a[i + j + len / 2] = u - v;
+						w *= root;
+					}
+				}
+			}
+		}
+	}
+
+	/**
+	 * @brief Taylor polynomial of a function, with the coefficients from Taylor-mode AD.
+	 * 
+	 * @tparam Order The degree of the polynomial.
+	 * @param fx A template/generic callable, evaluated once on Jet<Order>.
+	 * @param center The point to expand around.
+	 * @return BasicPolynomial<T> The Taylor polynomial.
+	 * 
+	 * @see taylor_coefficients()
+	 * 
+	 */
+	template<std::size_t Order, typename T = double, typename F>
+	BasicPolynomial<T> taylor(F &&fx, NoDeduce<T> center)
+	{
+		std::array<T, Order + 1> c = taylor_coefficients<Order, T>(fx, center);
+		return BasicPolynomial<T>(std::vector<T>(c.begin(), c.end()), center);
+	}
+
+	/**
+	 * @brief Taylor polynomial of an analytic function, with the coefficients from Cauchy's integral formula.
+	 * 
+	 * @param fx The function, which has to be analytic on the disc around center of the given radius.
+	 * @param center The point to expand around.
+	 * @param order The degree of the polynomial.
+	 * @param radius Radius of the sampling circle. It has to be inside the radius of convergence;
+	 * 		larger radii are more accurate for the high coefficients, until they near a singularity.
+	 * @return Polynomial The Taylor polynomial.
+	 * 
+	 * @remarks c_k = 1/(2 pi i) \oint f(z) / (z - center)^(k+1) dz, which the trapezoidal rule on M points around the circle turns
+	 * 		into a single FFT of the samples. Costs M complex evaluations, with M the power of 2 at least twice the amount of coefficients.
+	 * 
+	 */
+	inline Polynomial taylor(CFunc fx, double center, unsigned order, double radius = 1)
+	{
+		std::size_t m = 16;
+		while(m < 2 * (std::size_t(order) + 1))
+		{
+			m *= 2;
+		}
+		std::vector<std::complex<double>> samples(m);
+		for(std::size_t j = 0; j < m; ++j)
+		{
+			samples[j] = fx(center + std::polar(radius, 2 * PI * j / m));
+		}
+		detail::fft(samples);
+		std::vector<double> c(order + 1);
+		double scale = 1.0 / m;
+		for(unsigned k = 0; k <= order; ++k)
+		{
+			c[k] = std::real(samples[k]) * scale;
+			scale /= radius;
+		}
+		return Polynomial(c, center);
+	}
+
+	//////////////////////////QUADRATURE/////////////////////////////
+
+	/**
+	 * @brief Implementation details. Nothing in here is meant to be called directly.
+	 * 
+	 */
+	namespace detail
+	{
+		/**
+		 * @brief One abscissa/weight pair of a double-exponential rule, at position t of the transformed axis.
+		 * 
+		 */
+		template<typename T>
+		struct DENode
+		{
+			T t;
+			T x;
+			T w;
+		};
+
+		/**
+		 * @brief Abscissa/weight table of a double-exponential rule, generated once per level and cached.
+		 * 
+		 * @remarks Level 0 holds the nodes at every integer t, level k > 0 only the new nodes at odd multiples of 2^-k,
+		 * 		so levels 0..k together make up the full rule with step 2^-k. Symmetric tables only hold t >= 0.
+		 * 
+		 */
+		template<typename T>
+		class DETable
+		{
+		public:
+			DETable(std::function<DENode<T>(T)> node, T tmin, T tmax, bool symmetric)
+				: mNode(node), mTmin(tmin), mTmax(tmax), mSymmetric(symmetric)
+			{
+			}
+
+			/**
+			 * @brief Returns the nodes of a level, generating it (and any level before it) if needed.
+			 * 
+			 * @remarks Levels live in a deque, so references handed out stay valid while other threads add levels.
+			 * 
+			 */
+			const std::vector<DENode<T>>& level(unsigned k)
+			{
+				std::lock_guard<std::mutex> lock(mMutex);
+				while(mLevels.size() <= k)
+				{
+					generate(mLevels.size());
+				}
+				return mLevels[k];
+			}
+
+			bool symmetric() const
+			{
+				return mSymmetric;
+			}
+
+		private:
+			std::function<DENode<T>(T)> mNode;
+			T mTmin;
+			T mTmax;
+			bool mSymmetric;
+			std::deque<std::vector<DENode<T>>> mLevels;
+			std::mutex mMutex;
+
+			void generate(unsigned k)
+			{
+				std::vector<DENode<T>> nodes;
+				T h = detail::ldexp(T(1), -int(k));
+				long first = long(detail::ceil(mTmin / h));
+				long last = long(detail::floor(mTmax / h));
+				for(long j = first; j <= last; ++j)
+				{
+					//Even multiples were already generated by a coarser level.
+					if(k > 0 && j % 2 == 0)
+					{
+						continue;
+					}
+					DENode<T> n = mNode(j * h);
+					//Drop nodes whose weight or abscissa no longer fit in a T.
+					if(detail::isfinite(n.x) && detail::isfinite(n.w) && n.w > 0)
+					{
+						nodes.push_back(n);
+					}
+				}
+				mLevels.push_back(nodes);
+			}
+		};
+
+		/**
+		 * @brief Sums a double-exponential rule level by level until two successive levels agree.
+		 * 
+		 * @param table The rule's node table.
+		 * @param term Returns w*f(x) for a node on the given side (-1 left, 1 right, 0 center), or a non-finite value if the point is unusable.
+		 * @param scale The factor mapping the transformed integral back to the requested one.
+		 * @param opts Tolerances (the relative one measured against the L1 norm of the integrand), finest level and evaluation budget.
+		 * @return BasicEstimate<T> The integral.
+		 * 
+		 * @remarks Each side is truncated once its terms drop below machine precision, or right before the first
+		 * 		non-finite term (a singular endpoint rounding onto the abscissa), so finer levels skip the dead tails.
+		 * 		A tail cut by a non-finite term is counted in the error, since it may still hold a good part of the integral.
+		 * 
+		 */
+		template<typename T>
+		BasicEstimate<T> de_integrate(DETable<T> &table, std::function<T(const DENode<T>&, int)> term,
+									  T scale, const BasicOptions<T> &opts)
+		{
+			const T eps = epsilon<T>();
+			BasicEstimate<T> est = {0, infinity<T>(), 0};
+			//Largest |t| (exclusive) still summed on each side; [0] is the left side, [1] the right side.
+			T cutoff[2] = {infinity<T>(), infinity<T>()};
+			//The outermost finite term on each side, and whether a non-finite one cut that side short of its tail.
+			T edge[2] = {0, 0};
+			T edgeT[2] = {0, 0};
+			bool truncated[2] = {false, false};
+			T sum = 0;
+			T l1 = 0;
+			T previous = 0;
+			//Level 0 terms off the center, kept to find where the tails stop mattering.
+			struct Tail
+			{
+				int side;
+				T t;
+				T magnitude;
+			};
+			std::vector<Tail> tails;
+
+			for(unsigned k = 0; k <= opts.max_level && est.evaluations < opts.max_evaluations; ++k)
+			{
+				T h = detail::ldexp(T(1), -int(k));
+				for(const DENode<T> &node : table.level(k))
+				{
+					//Which sides this node is summed on.
+					int sides[2] = {-1, 1};
+					int count = 1;
+					if(node.t == 0)
+					{
+						sides[0] = 0;
+					}
+					else if(table.symmetric())
+					{
+						count = 2;
+					}
+					else
+					{
+						sides[0] = (node.t < 0) ? (-1) : (1);
+					}
+
+					for(int s = 0; s < count; ++s)
+					{
+						int idx = (sides[s] < 0) ? (0) : (1);
+						T at = detail::abs(node.t);
+						if(at >= cutoff[idx])
+						{
+							continue;
+						}
+						T value = term(node, sides[s]);
+						++est.evaluations;
+						if(!detail::isfinite(value))
+						{
+							//The point collapsed onto a singularity; nothing further out is usable either.
+							cutoff[idx] = at;
+							truncated[idx] = true;
+							continue;
+						}
+						sum += value;
+						l1 += detail::abs(value);
+						if(sides[s] != 0 && at > edgeT[idx])
+						{
+							edgeT[idx] = at;
+							edge[idx] = detail::abs(value);
+						}
+						if(k == 0 && sides[s] != 0)
+						{
+							tails.push_back({idx, at, detail::abs(value)});
+						}
+					}
+				}
+
+				if(k == 0)
+				{
+					//Trim each side one level 0 step past the last term that still matters.
+					T last[2] = {0, 0};
+					for(const Tail &tail : tails)
+					{
+						if(tail.magnitude > eps * detail::abs(sum))
+						{
+							last[tail.side] = std::max(last[tail.side], tail.t);
+						}
+					}
+					for(int idx = 0; idx < 2; ++idx)
+					{
+						cutoff[idx] = std::min(cutoff[idx], last[idx] + 1);
+					}
+				}
+
+				est.value = scale * h * sum;
+				if(k > 0)
+				{
+					est.error = detail::abs(est.value - previous);
+					const bool converged = est.error <= opts.rel_tol * detail::abs(scale) * h * l1 || est.error <= opts.abs_tol;
+					//A cut tail isn't refined away by finer levels, so it only widens the error. It decays double exponentially
+					//in t, so past the last finite term it adds up to less than that term over a unit of t.
+					for(int idx = 0; idx < 2; ++idx)
+					{
+						if(truncated[idx])
+						{
+							est.error += detail::abs(scale) * edge[idx];
+						}
+					}
+					if(k >= 2 && converged)
+					{
+						return est;
+					}
+				}
+				previous = est.value;
+			}
+			return est;
+		}
+
+		/**
+		 * @brief Tanh-sinh node: x holds the complement 1-|x| so abscissas next to an endpoint keep their precision.
+		 * 
+		 */
+		template<typename T>
+		DENode<T> tanh_sinh_node(T t)
+		{
+			T u = pi<T>() / 2 * sinh(t);
+			T cu = cosh(u);
+			return {t, 1 / (exp(u) * cu), pi<T>() / 2 * cosh(t) / (cu * cu)};
+		}
+
+		/**
+		 * @brief Exp-sinh node, mapping (-inf, inf) onto (0, inf).
+		 * 
+		 */
+		template<typename T>
+		DENode<T> exp_sinh_node(T t)
+		{
+			T x = exp(pi<T>() / 2 * sinh(t));
+			return {t, x, pi<T>() / 2 * cosh(t) * x};
+		}
+
+		/**
+		 * @brief Sinh-sinh node, mapping (-inf, inf) onto itself.
+		 * 
+		 */
+		template<typename T>
+		DENode<T> sinh_sinh_node(T t)
+		{
+			T u = pi<T>() / 2 * sinh(t);
+			return {t, sinh(u), pi<T>() / 2 * cosh(t) * cosh(u)};
+		}
+
+		template<typename T>
+		DETable<T> &tanh_sinh_table()
+		{
+			static DETable<T> table(tanh_sinh_node<T>, 0, T(6.5), true);
+			return table;
+		}
+
+		template<typename T>
+		DETable<T> &exp_sinh_table()
+		{
+			static DETable<T> table(exp_sinh_node<T>, -7, 7, false);
+			return table;
+		}
+
+		template<typename T>
+		DETable<T> &sinh_sinh_table()
+		{
+			static DETable<T> table(sinh_sinh_node<T>, 0, 7, true);
+			return table;
+		}
+	}
+
+	/**
+	 * @brief Tanh-sinh quadrature over a finite interval.
+	 * 
+	 * @param fx The function to integrate. It is never evaluated at the end-points, so they may be singular.
+	 * @param lower The lower bound.
+	 * @param upper The upper bound.
+	 * @param opts Tolerances, finest level and evaluation budget. Convergence is quadratic, so the result is usually far better than rel_tol.
+	 * @return BasicEstimate<T> The definite integral.
+	 * 
+	 * @remarks Smooth integrands, and ones with algebraic or logarithmic end-point singularities,
+	 * 		converge to the full precision of T in a few hundred evaluations.
+	 * 
+	 */
+	template<typename T = double>
+	BasicEstimate<T> integral_tanh_sinh(BasicFunc<T> fx, NoDeduce<T> lower, NoDeduce<T> upper,
+										const BasicOptions<T> &opts = BasicOptions<T>())
+	{
+		if(lower == upper)
+		{
+			return {0, 0, 0};
+		}
+		T half = (upper - lower) / 2;
+		T mid = lower + half;
+		T a = std::min(lower, upper);
+		T b = std::max(lower, upper);
+		T width = detail::abs(half);
+		return detail::de_integrate<T>(detail::tanh_sinh_table<T>(), [&](const detail::DENode<T> &node, int side)->T{
+			if(side == 0)
+			{
+				return node.w * fx(mid);
+			}
+			//Measure from the nearest end-point, where the complement is exact.
+			T x = (side < 0) ? (a + width * node.x) : (b - width * node.x);
+			if(x <= a || x >= b)
+			{
+				return T(NAN);
+			}
+			return node.w * fx(x);
+		}, half, opts);
+	}
+
+	/**
+	 * @brief Exp-sinh quadrature over [lower, inf).
+	 * 
+	 * @param fx The function to integrate. It has to decay, and may be singular at lower.
+	 * @param lower The lower bound.
+	 * @param opts Tolerances, finest level and evaluation budget.
+	 * @return BasicEstimate<T> The integral from lower to infinity.
+	 * 
+	 */
+	template<typename T = double>
+	BasicEstimate<T> integral_exp_sinh(BasicFunc<T> fx, NoDeduce<T> lower, const BasicOptions<T> &opts = BasicOptions<T>())
+	{
+		return detail::de_integrate<T>(detail::exp_sinh_table<T>(), [&](const detail::DENode<T> &node, int)->T{
+			T x = lower + node.x;
+			if(x == lower || !detail::isfinite(x))
+			{
+				return T(NAN);
+			}
+			return node.w * fx(x);
+		}, 1, opts);
+	}
+
+	/**
+	 * @brief Sinh-sinh quadrature over the whole real line.
+	 * 
+	 * @param fx The function to integrate. It has to decay in both directions.
+	 * @param opts Tolerances, finest level and evaluation budget.
+	 * @return BasicEstimate<T> The integral from -inf to inf.
+	 * 
+	 */
+	template<typename T = double>
+	BasicEstimate<T> integral_sinh_sinh(BasicFunc<T> fx, const BasicOptions<T> &opts = BasicOptions<T>())
+	{
+		return detail::de_integrate<T>(detail::sinh_sinh_table<T>(), [&](const detail::DENode<T> &node, int side)->T{
+			T x = (side < 0) ? (-node.x) : (node.x);
+			return node.w * fx(x);
+		}, 1, opts);
+	}
+
+	/**
+	 * @brief Definite integral where either bound may be INF or -INF, picking the right double-exponential rule.
+	 * 
+	 * @param fx The function to integrate.
+	 * @param lower The lower bound, possibly -INF.
+	 * @param upper The upper bound, possibly INF.
+	 * @param opts Tolerances, finest level and evaluation budget.
+	 * @return BasicEstimate<T> The integral.
+	 * 
+	 * @see integral_tanh_sinh(), integral_exp_sinh(), integral_sinh_sinh()
+	 * 
+	 */
+	template<typename T>
+	BasicEstimate<T> integral_improper(BasicFunc<T> fx, NoDeduce<T> lower, NoDeduce<T> upper, const BasicOptions<T> &opts)
+	{
+		if(lower > upper)
+		{
+			BasicEstimate<T> est = integral_improper<T>(fx, upper, lower, opts);
+			est.value = -est.value;
+			return est;
+		}
+		if(detail::isinf(lower) && detail::isinf(upper))
+		{
+			return integral_sinh_sinh<T>(fx, opts);
+		}
+		if(detail::isinf(upper))
+		{
+			return integral_exp_sinh<T>(fx, lower, opts);
+		}
+		if(detail::isinf(lower))
+		{
+			//Reflect (-inf, upper] onto [-upper, inf).
+			return integral_exp_sinh<T>([&](T x)->T{
+				return fx(-x);
+			}, -upper, opts);
+		}
+		return integral_tanh_sinh<T>(fx, lower, upper, opts);
+	}
+
+	/**
+	 * @brief Nodes and weights of an N-point quadrature rule on [-1, 1], in ascending order of node.
+	 * 
+	 */
+	template<std::size_t N, typename T = double>
+	struct QuadratureRule
+	{
+		std::array<T, N> nodes;
+		std::array<T, N> weights;
+	};
+
+	namespace detail
+	{
+		/**
+		 * @brief constexpr cosine on [0, pi], only precise enough to seed Newton's method.
+		 * 
+		 */
+		constexpr double cos_seed(double x)
+		{
+			double term = 1;
+			double sum = 1;
+			for(int k = 1; k < 30; ++k)
+			{
+				term *= -x * x / ((2 * k - 1) * (2 * k));
+				sum += term;
+			}
+			return sum;
+		}
+
+		/**
+		 * @brief P_n(x) and P_{n-1}(x), the Legendre polynomials, through their three-term recurrence.
+		 * 
+		 */
+		template<typename T>
+		struct LegendrePair
+		{
+			T p;
+			T previous;
+		};
+
+		template<typename T>
+		constexpr LegendrePair<T> legendre(std::size_t n, T x)
+		{
+			T previous = 1;
+			T p = x;
+			if(n == 0)
+			{
+				return {1, 0};
+			}
+			for(std::size_t k = 2; k <= n; ++k)
+			{
+				T next = (T(2 * k - 1) * x * p - T(k - 1) * previous) / T(k);
+				previous = p;
+				p = next;
+			}
+			return {p, previous};
+		}
+	}
+
+	/**
+	 * @brief Gauss-Legendre nodes and weights, computed entirely at compile-time.
+	 * 
+	 * @tparam N The amount of nodes. The rule is exact for polynomials of degree 2N-1.
+	 * @tparam T The scalar type of the nodes and weights.
+	 * @return QuadratureRule<N, T> The rule on [-1, 1].
+	 * 
+	 * @remarks Each root is polished with Newton's method on P_N until the steps stop shrinking, which is
+	 * 		the last bit of whatever T is, and mirrored so the rule is exactly symmetric.
+	 * 
+	 */
+	template<std::size_t N, typename T = double>
+	constexpr QuadratureRule<N, T> gauss_legendre()
+	{
+		static_assert(N >= 1, "A Gauss-Legendre rule needs at least one node.");
+		QuadratureRule<N, T> rule{};
+		for(std::size_t i = 0; i < (N + 1) / 2; ++i)
+		{
+			T x = detail::cos_seed(3.14159265358979323846 * (i + 0.75) / (N + 0.5));
+			T previous = 1;
+			for(int iter = 0; iter < 100; ++iter)
+			{
+				detail::LegendrePair<T> lp = detail::legendre(N, x);
+				T dp = T(N) * (x * lp.p - lp.previous) / (x * x - 1);
+				T dx = lp.p / dp;
+				T size = (dx < 0) ? (-dx) : (dx);
+				x -= dx;
+				if(size == 0 || size >= previous)
+				{
+					break;
+				}
+				previous = size;
+			}
+			detail::LegendrePair<T> lp = detail::legendre(N, x);
+			T dp = T(N) * (x * lp.p - lp.previous) / (x * x - 1);
+			//The root nearest the middle of an odd rule is exactly 0.
+			if(2 * i + 1 == N)
+			{
+				x = 0;
+			}
+			T w = 2 / ((1 - x * x) * dp * dp);
+			rule.nodes[i] = -x;
+			rule.nodes[N - 1 - i] = x;
+			rule.weights[i] = w;
+			rule.weights[N - 1 - i] = w;
+		}
+		return rule;
+	}
+
+	/**
+	 * @brief Gauss-Lobatto nodes and weights, computed entirely at compile-time.
+	 * 
+	 * @tparam N The amount of nodes, including both end-points. The rule is exact for polynomials of degree 2N-3.
+	 * @tparam T The scalar type of the nodes and weights.
+	 * @return QuadratureRule<N, T> The rule on [-1, 1].
+	 * 
+	 * @remarks The interior nodes are the roots of P'_{N-1}, found with Newton's method from Chebyshev-Lobatto guesses.
+	 * 
+	 */
+	template<std::size_t N, typename T = double>
+	constexpr QuadratureRule<N, T> gauss_lobatto()
+	{
+		static_assert(N >= 2, "A Gauss-Lobatto rule needs at least both end-points.");
+		const std::size_t n = N - 1;
+		QuadratureRule<N, T> rule{};
+		for(std::size_t i = 0; i < (N + 1) / 2; ++i)
+		{
+			T x = 1;
+			if(i > 0)
+			{
+				x = detail::cos_seed(3.14159265358979323846 * i / n);
+				T previous = 1;
+				for(int iter = 0; iter < 100; ++iter)
+				{
+					detail::LegendrePair<T> lp = detail::legendre(n, x);
+					T dp = T(n) * (x * lp.p - lp.previous) / (x * x - 1);
+					T ddp = (2 * x * dp - T(n * (n + 1)) * lp.p) / (1 - x * x);
+					T dx = dp / ddp;
+					T size = (dx < 0) ? (-dx) : (dx);
+					x -= dx;
+					if(size == 0 || size >= previous)
+					{
+						break;
+					}
+					previous = size;
+				}
+			}
+			if(2 * i + 1 == N)
+			{
+				x = 0;
+			}
+			T p = detail::legendre(n, x).p;
+			T w = 2 / (T(n * (n + 1)) * p * p);
+			rule.nodes[i] = -x;
+			rule.nodes[N - 1 - i] = x;
+			rule.weights[i] = w;
+			rule.weights[N - 1 - i] = w;
+		}
+		return rule;
+	}
+
+	/**
+	 * @brief Fixed-order Gauss-Legendre integration, split into equal panels.
+	 * 
+	 * @tparam N The order of the rule on every panel.
+	 * @param fx The function to integrate. Any callable works; passing a lambda directly lets it inline.
+	 * @param lower The lower bound.
+	 * @param upper The upper bound.
+	 * @param panels The amount of equal-width panels to split [lower, upper] into.
+	 * @return T The definite integral.
+	 * 
+	 * @remarks The rule is a compile-time constant, so each panel is just an unrolled dot product.
+	 * 
+	 */
+	template<std::size_t N, typename T = double, typename F>
+	T integral_gauss(F &&fx, NoDeduce<T> lower, NoDeduce<T> upper, unsigned panels = 1)
+	{
+		constexpr QuadratureRule<N, T> rule = gauss_legendre<N, T>();
+		T half = (upper - lower) / (2 * panels);
+		T ret = 0;
+		for(unsigned p = 0; p < panels; ++p)
+		{
+			T mid = lower + (2 * p + 1) * half;
+			T panel = 0;
+			for(std::size_t i = 0; i < N; ++i)
+			{
+				panel += rule.weights[i] * fx(mid + half * rule.nodes[i]);
+			}
+			ret += panel;
+		}
+		return ret * half;
+	}
+
+	//////////////////////////CURVES/////////////////////////////
+
+	namespace detail
+	{
+		/**
+		 * @brief How fast one coordinate of a curve moves, for the integrands below. Good to about 12 digits.
+		 * 
+		 * @param finite Cleared if the difference isn't finite.
+		 * @return T The derivative, or NAN if t is too close to a bound to take it, like a tanh-sinh node collapsing onto it.
+		 * 
+		 * @remarks A five-point difference, with the step scaled to the distance to the nearer bound as well as to t,
+		 * 		so fx is never evaluated outside [lower, upper] and a singular end is resolved as well as the middle.
+		 * 		Right next to a smooth end, the short step costs digits, but only where the quadrature's weights are tiny.
+		 * 
+		 */
+		template<typename T>
+		T velocity(const BasicFunc<T> &fx, T t, T lower, T upper, bool &finite)
+		{
+			const T scale = std::min({std::max(detail::abs(t), T(1)), detail::abs(t - lower), detail::abs(upper - t)});
+			const T h = exact_step(t, detail::pow(epsilon<T>(), T(0.2)) * scale);
+			if(h == 0)
+			{
+				return T(NAN);
+			}
+			const T slope = (fx(t - 2 * h) - 8 * fx(t - h) + 8 * fx(t + h) - fx(t + 2 * h)) / (12 * h);
+			finite = finite && detail::isfinite(slope);
+			return slope;
+		}
+	}
+
+	/**
+	 * @brief Length of the graph of a function.
+	 * 
+	 * @param fx The function. It has to be differentiable inside the bounds, and is only evaluated inside them.
+	 * @param lower The lower bound.
+	 * @param upper The upper bound.
+	 * @param opts Tolerances, finest level and evaluation budget of the quadrature.
+	 * @return BasicEstimate<T> The length of the graph between the bounds. The error is infinite if a derivative wasn't finite.
+	 * 
+	 * @remarks The integral of sqrt(1 + f'(x)^2) by tanh-sinh quadrature, with five-point derivatives.
+	 * 		The error is the quadrature's estimate, so it doesn't count the derivatives' own error, relative 1e-12 or so for doubles.
+	 * 
+	 */
+	template<typename T = double>
+	BasicEstimate<T> arc_length(BasicFunc<T> fx, NoDeduce<T> lower, NoDeduce<T> upper, const BasicOptions<T> &opts = BasicOptions<T>())
+	{
+		bool finite = true;
+		BasicEstimate<T> est = integral_tanh_sinh<T>([&](T x)->T{
+			T slope = detail::velocity<T>(fx, x, lower, upper, finite);
+			return detail::sqrt(1 + slope * slope);
+		}, lower, upper, opts);
+		est.evaluations *= 4;
+		if(!finite)
+		{
+			est.error = detail::infinity<T>();
+		}
+		return est;
+	}
+
+	/**
+	 * @brief Length of a parametric curve, (x(t), y(t)).
+	 * 
+	 * @param x The x-coordinate at t. Both coordinates have to be differentiable inside the bounds, and are only evaluated inside them.
+	 * @param y The y-coordinate at t.
+	 * @param lower The first t.
+	 * @param upper The last t.
+	 * @param opts Tolerances, finest level and evaluation budget of the quadrature.
+	 * @return BasicEstimate<T> The length of the curve, counting any part it traces more than once every time.
+	 * 		The error is infinite if a derivative wasn't finite.
+	 * 
+	 * @remarks Where the curve has a cusp, its speed has a kink, which costs the quadrature most of its digits.
+	 * 		Split the range there for full precision.
+	 * 
+	 * @see arc_length()
+	 * 
+	 */
+	template<typename T = double>
+	BasicEstimate<T> arc_length_parametric(BasicFunc<T> x, BasicFunc<T> y, NoDeduce<T> lower, NoDeduce<T> upper,
+										   const BasicOptions<T> &opts = BasicOptions<T>())
+	{
+		bool finite = true;
+		BasicEstimate<T> est = integral_tanh_sinh<T>([&](T t)->T{
+			T dx = detail::velocity<T>(x, t, lower, upper, finite);
+			T dy = detail::velocity<T>(y, t, lower, upper, finite);
+			return detail::sqrt(dx * dx + dy * dy);
+		}, lower, upper, opts);
+		est.evaluations *= 8;
+		if(!finite)
+		{
+			est.error = detail::infinity<T>();
+		}
+		return est;
+	}
+
+	/**
+	 * @brief Length of a polar curve, r(theta).
+	 * 
+	 * @param r The distance from the origin at theta. It has to be differentiable inside the bounds, and is only evaluated inside them.
+	 * @param lower The first angle, in radians.
+	 * @param upper The last angle.
+	 * @param opts Tolerances, finest level and evaluation budget of the quadrature.
+	 * @return BasicEstimate<T> The length of the curve. The error is infinite if a derivative wasn't finite.
+	 * 
+	 * @see arc_length(), arc_length_parametric()
+	 * 
+	 */
+	template<typename T = double>
+	BasicEstimate<T> arc_length_polar(BasicFunc<T> r, NoDeduce<T> lower, NoDeduce<T> upper, const BasicOptions<T> &opts = BasicOptions<T>())
+	{
+		bool finite = true;
+		BasicEstimate<T> est = integral_tanh_sinh<T>([&](T theta)->T{
+			T radius = r(theta);
+			T dr = detail::velocity<T>(r, theta, lower, upper, finite);
+			return detail::sqrt(radius * radius + dr * dr);
+		}, lower, upper, opts);
+		est.evaluations *= 5;
+		if(!finite)
+		{
+			est.error = detail::infinity<T>();
+		}
+		return est;
+	}
+
+	/**
+	 * @brief Signed area swept by a parametric curve, (x(t), y(t)), as seen from the origin.
+	 * 
+	 * @param x The x-coordinate at t. Both coordinates have to be differentiable inside the bounds, and are only evaluated inside them.
+	 * @param y The y-coordinate at t.
+	 * @param lower The first t.
+	 * @param upper The last t.
+	 * @param opts Tolerances, finest level and evaluation budget of the quadrature.
+	 * @return BasicEstimate<T> The area, positive where the curve turns counter-clockwise.
+	 * 		For a closed curve, that's the area it encloses, wherever the origin is. The error is infinite if a derivative wasn't finite.
+	 * 
+	 * @remarks Green's theorem: the integral of (x y' - y x') / 2.
+	 * 
+	 */
+	template<typename T = double>
+	BasicEstimate<T> area_parametric(BasicFunc<T> x, BasicFunc<T> y, NoDeduce<T> lower, NoDeduce<T> upper,
+									 const BasicOptions<T> &opts = BasicOptions<T>())
+	{
+		bool finite = true;
+		BasicEstimate<T> est = integral_tanh_sinh<T>([&](T t)->T{
+			T dx = detail::velocity<T>(x, t, lower, upper, finite);
+			T dy = detail::velocity<T>(y, t, lower, upper, finite);
+			return (x(t) * dy - y(t) * dx) / 2;
+		}, lower, upper, opts);
+		est.evaluations *= 10;
+		if(!finite)
+		{
+			est.error = detail::infinity<T>();
+		}
+		return est;
+	}
+
+	/**
+	 * @brief Area swept by a polar curve, r(theta).
+	 * 
+	 * @param r The distance from the origin at theta.
+	 * @param lower The first angle, in radians.
+	 * @param upper The last angle.
+	 * @param opts Tolerances, finest level and evaluation budget of the quadrature.
+	 * @return BasicEstimate<T> The area between the curve and the origin, counting anything swept twice twice.
+	 * 
+	 * @remarks The integral of r^2 / 2. No derivatives, so r only has to be integrable.
+	 * 
+	 */
+	template<typename T = double>
+	BasicEstimate<T> area_polar(BasicFunc<T> r, NoDeduce<T> lower, NoDeduce<T> upper, const BasicOptions<T> &opts = BasicOptions<T>())
+	{
+		return integral_tanh_sinh<T>([&](T theta)->T{
+			T radius = r(theta);
+			return radius * radius / 2;
+		}, lower, upper, opts);
+	}
+
+	//////////////////////////INTERVALS/////////////////////////////
+
+	namespace detail
+	{
+		/**
+		 * @brief Steps a computed lower bound ulps doubles towards -inf, so it's below the exact result.
+		 * 
+		 */
+		inline double down(double x, int ulps = 1)
+		{
+			for(int i = 0; i < ulps; ++i)
+			{
+				x = std::nextafter(x, -INF);
+			}
+			return x;
+		}
+
+		/**
+		 * @brief Steps a computed upper bound ulps doubles towards inf, so it's above the exact result.
+		 * 
+		 */
+		inline double up(double x, int ulps = 1)
+		{
+			for(int i = 0; i < ulps; ++i)
+			{
+				x = std::nextafter(x, INF);
+			}
+			return x;
+		}
+
+		/**
+		 * @brief A product where 0 times anything, infinity included, is 0.
+		 * 
+		 */
+		inline double product(double a, double b)
+		{
+			return (a == 0 || b == 0) ? (0) : (a * b);
+		}
+
+		/**
+		 * @brief Whether [lower, upper] may contain offset + 2k pi for some integer k. Errs on the side of yes.
+		 * 
+		 */
+		inline bool reaches(double lower, double upper, double offset)
+		{
+			double first = (lower - offset) / (2 * PI);
+			double last = (upper - offset) / (2 * PI);
+			double slack = 1e-9 + 1e-15 * std::max(std::abs(first), std::abs(last));
+			return std::floor(last + slack) >= std::ceil(first - slack);
+		}
+	}
+
+	/**
+	 * @brief A closed interval [lower, upper] of reals, rounded outward after every operation so it always encloses the exact result.
+	 * 
+	 * @remarks Directed rounding is done by stepping every computed bound outward with nextafter(), which needs no control over
+	 * 		the FPU's rounding mode. Elementary functions step two ulps, to also cover libm's own error.
+	 * 		Evaluating any generic callable on an Interval gives its natural interval extension: a range guaranteed to contain
+	 * 		f(x) for every x in the argument, if not always a tight one. Results that aren't real at all come out empty().
+	 * 
+	 */
+	class Interval
+	{
+	public:
+		/**
+		 * @brief The single point value. Also lets doubles mix freely with intervals.
+		 * 
+		 */
+		Interval(double value = 0)
+			: mLower(value), mUpper(value)
+		{
+		}
+
+		Interval(double lower, double upper)
+			: mLower(lower), mUpper(upper)
+		{
+		}
+
+		/**
+		 * @brief The whole real line.
+		 * 
+		 */
+		static Interval entire()
+		{
+			return Interval(-INF, INF);
+		}
+
+		double lower() const
+		{
+			return mLower;
+		}
+
+		double upper() const
+		{
+			return mUpper;
+		}
+
+		/**
+		 * @brief A point inside the interval, its midpoint when bounded.
+		 * 
+		 */
+		double mid() const
+		{
+			if(std::isinf(mLower) || std::isinf(mUpper))
+			{
+				return std::isinf(mLower) ? (std::isinf(mUpper) ? (0) : (std::min(mUpper, -LARGE))) : (std::max(mLower, LARGE));
+			}
+			return mLower + (mUpper - mLower) / 2;
+		}
+
+		double width() const
+		{
+			return mUpper - mLower;
+		}
+
+		/**
+		 * @brief The largest magnitude in the interval.
+		 * 
+		 */
+		double magnitude() const
+		{
+			return std::max(std::abs(mLower), std::abs(mUpper));
+		}
+
+		bool contains(double x) const
+		{
+			return mLower <= x && x <= mUpper;
+		}
+
+		/**
+		 * @brief Whether other lies strictly inside this interval, away from both end-points.
+		 * 
+		 */
+		bool interior(const Interval &other) const
+		{
+			return mLower < other.mLower && other.mUpper < mUpper;
+		}
+
+		bool empty() const
+		{
+			return !(mLower <= mUpper);
+		}
+
+		Interval &operator+=(const Interval &other)
+		{
+			mLower = detail::down(mLower + other.mLower);
+			mUpper = detail::up(mUpper + other.mUpper);
+			return *this;
+		}
+
+		Interval &operator-=(const Interval &other)
+		{
+			mLower = detail::down(mLower - other.mUpper);
+			mUpper = detail::up(mUpper - other.mLower);
+			return *this;
+		}
+
+		Interval &operator*=(const Interval &other)
+		{
+			double p[4] = {detail::product(mLower, other.mLower), detail::product(mLower, other.mUpper),
+						   detail::product(mUpper, other.mLower), detail::product(mUpper, other.mUpper)};
+			mLower = detail::down(*std::min_element(p, p + 4));
+			mUpper = detail::up(*std::max_element(p, p + 4));
+			return *this;
+		}
+
+		Interval &operator/=(const Interval &other)
+		{
+			//Dividing by anything that may be 0 could give anything.
+			if(other.contains(0))
+			{
+				return *this = entire();
+			}
+			double q[4] = {mLower / other.mLower, mLower / other.mUpper, mUpper / other.mLower, mUpper / other.mUpper};
+			mLower = detail::down(*std::min_element(q, q + 4));
+			mUpper = detail::up(*std::max_element(q, q + 4));
+			return *this;
+		}
+
+	private:
+		double mLower;
+		double mUpper;
+	};
+
+	inline Interval operator+(Interval a, const Interval &b) { return a += b; }
+	inline Interval operator-(Interval a, const Interval &b) { return a -= b; }
+	inline Interval operator*(Interval a, const Interval &b) { return a *= b; }
+	inline Interval operator/(Interval a, const Interval &b) { return a /= b; }
+	inline Interval operator+(const Interval &a) { return a; }
+	inline Interval operator-(const Interval &a) { return Interval(-a.upper(), -a.lower()); }
+
+	/**
+	 * @brief The smallest interval containing both.
+	 * 
+	 */
+	inline Interval hull(const Interval &a, const Interval &b)
+	{
+		if(a.empty() || b.empty())
+		{
+			return a.empty() ? (b) : (a);
+		}
+		return Interval(std::min(a.lower(), b.lower()), std::max(a.upper(), b.upper()));
+	}
+
+	/**
+	 * @brief The overlap of two intervals, which is empty() if they don't overlap.
+	 * 
+	 */
+	inline Interval intersect(const Interval &a, const Interval &b)
+	{
+		return Interval(std::max(a.lower(), b.lower()), std::min(a.upper(), b.upper()));
+	}
+
+	/*
+	Elementary functions. Monotone ones just map the end-points; the rest also check for the extrema in between.
+	*/
+
+	inline Interval sqrt(const Interval &a)
+	{
+		if(a.upper() < 0)
+		{
+			return Interval(NAN, NAN);
+		}
+		double lower = (a.lower() <= 0) ? (0) : (std::max(0.0, detail::down(std::sqrt(a.lower()))));
+		return Interval(lower, detail::up(std::sqrt(a.upper())));
+	}
+
+	inline Interval exp(const Interval &a)
+	{
+		return Interval(std::max(0.0, detail::down(std::exp(a.lower()), 2)), detail::up(std::exp(a.upper()), 2));
+	}
+
+	inline Interval log(const Interval &a)
+	{
+		if(a.upper() < 0)
+		{
+			return Interval(NAN, NAN);
+		}
+		double lower = (a.lower() <= 0) ? (-INF) : (detail::down(std::log(a.lower()), 2));
+		return Interval(lower, detail::up(std::log(a.upper()), 2));
+	}
+
+	inline Interval abs(const Interval &a)
+	{
+		if(a.contains(0))
+		{
+			return Interval(0, a.magnitude());
+		}
+		return (a.lower() > 0) ? (a) : (-a);
+	}
+
+	inline Interval pow(const Interval &a, double p)
+	{
+		if(p != std::floor(p) || std::abs(p) > 1e9)
+		{
+			return exp(p * log(a));
+		}
+		int n = int(p);
+		if(n == 0)
+		{
+			return Interval(1);
+		}
+		if(n < 0)
+		{
+			return 1 / pow(a, -n);
+		}
+		//Even powers are monotone in |x|, odd ones in x.
+		Interval base = (n % 2 == 0) ? (abs(a)) : (a);
+		double lower = detail::down(std::pow(base.lower(), n), 2);
+		if(n % 2 == 0)
+		{
+			lower = std::max(lower, 0.0);
+		}
+		return Interval(lower, detail::up(std::pow(base.upper(), n), 2));
+	}
+
+	inline Interval sin(const Interval &a)
+	{
+		if(!std::isfinite(a.lower()) || !std::isfinite(a.upper()) || a.width() >= 2 * PI)
+		{
+			return Interval(-1, 1);
+		}
+		double lower = detail::down(std::min(std::sin(a.lower()), std::sin(a.upper())), 2);
+		double upper = detail::up(std::max(std::sin(a.lower()), std::sin(a.upper())), 2);
+		if(detail::reaches(a.lower(), a.upper(), PI / 2))
+		{
+			upper = 1;
+		}
+		if(detail::reaches(a.lower(), a.upper(), -PI / 2))
+		{
+			lower = -1;
+		}
+		return Interval(std::max(lower, -1.0), std::min(upper, 1.0));
+	}
+
+	inline Interval cos(const Interval &a)
+	{
+		if(!std::isfinite(a.lower()) || !std::isfinite(a.upper()) || a.width() >= 2 * PI)
+		{
+			return Interval(-1, 1);
+		}
+		double lower = detail::down(std::min(std::cos(a.lower()), std::cos(a.upper())), 2);
+		double upper = detail::up(std::max(std::cos(a.lower()), std::cos(a.upper())), 2);
+		if(detail::reaches(a.lower(), a.upper(), 0))
+		{
+			upper = 1;
+		}
+		if(detail::reaches(a.lower(), a.upper(), PI))
+		{
+			lower = -1;
+		}
+		return Interval(std::max(lower, -1.0), std::min(upper, 1.0));
+	}
+
+	inline Interval tan(const Interval &a)
+	{
+		//Poles at pi/2 + k pi.
+		if(!std::isfinite(a.width()) || a.width() >= PI
+		   || detail::reaches(a.lower(), a.upper(), PI / 2) || detail::reaches(a.lower(), a.upper(), -PI / 2))
+		{
+			return Interval::entire();
+		}
+		return Interval(detail::down(std::tan(a.lower()), 2), detail::up(std::tan(a.upper()), 2));
+	}
+
+	inline Interval atan(const Interval &a)
+	{
+		return Interval(detail::down(std::atan(a.lower()), 2), detail::up(std::atan(a.upper()), 2));
+	}
+
+	inline Interval sinh(const Interval &a)
+	{
+		return Interval(detail::down(std::sinh(a.lower()), 2), detail::up(std::sinh(a.upper()), 2));
+	}
+
+	inline Interval cosh(const Interval &a)
+	{
+		Interval m = abs(a);
+		return Interval(std::max(1.0, detail::down(std::cosh(m.lower()), 2)), detail::up(std::cosh(m.upper()), 2));
+	}
+
+	inline Interval tanh(const Interval &a)
+	{
+		return Interval(std::max(-1.0, detail::down(std::tanh(a.lower()), 2)), std::min(1.0, detail::up(std::tanh(a.upper()), 2)));
+	}
+
+	/**
+	 * @brief Encloses the range of a function over [lower, upper], splitting it into pieces to tighten the interval extension.
+	 * 
+	 * @param fx A template/generic callable, evaluated on Interval.
+	 * @param lower The lower bound.
+	 * @param upper The upper bound.
+	 * @param pieces The amount of equal pieces to evaluate fx on. Overestimation shrinks in proportion.
+	 * @return Interval Contains f(x) for every x in [lower, upper].
+	 * 
+	 */
+	template<typename F>
+	Interval enclose(F &&fx, double lower, double upper, unsigned pieces = 16)
+	{
+		Interval ret(NAN, NAN);
+		double start = lower;
+		for(unsigned i = 1; i <= pieces; ++i)
+		{
+			//The last piece ends exactly on upper, so the pieces cover [lower, upper] whatever the rounding.
+			double end = (i == pieces) ? (upper) : (lower + (upper - lower) * i / pieces);
+			ret = hull(ret, fx(Interval(start, end)));
+			start = end;
+		}
+		return ret;
+	}
+
+	/**
+	 * @brief A root isolated by roots_interval().
+	 * 
+	 */
+	struct RootEnclosure
+	{
+		/**
+		 * @brief An interval containing the root.
+		 * 
+		 */
+		Interval bounds;
+
+		/**
+		 * @brief Whether bounds is proven to contain exactly one root. If not, it may hold several, or none at all.
+		 * 
+		 */
+		bool unique;
+	};
+
+	/**
+	 * @brief Finds every root of a function in [lower, upper] with the interval Newton method, with proof.
+	 * 
+	 * @param fx A template/generic callable, evaluated on Interval and on Jet<1, Interval>.
+	 * @param lower The lower bound.
+	 * @param upper The upper bound.
+	 * @param opts The width to refine the enclosures to, from rel_tol and abs_tol, and the evaluation budget.
+	 * @return std::vector<RootEnclosure> The enclosures in ascending order. Every root in [lower, upper] is inside one of them.
+	 * 
+	 * @remarks The Newton operator N(X) = m - f(m) / f'(X) is evaluated with f'(X) enclosed by Taylor-mode AD on intervals.
+	 * 		Any root in X is also in N(X), so parts of X outside it are discarded, and N(X) inside X proves there's exactly one root.
+	 * 		Boxes where f' may vanish are bisected instead. Roots of even multiplicity can't be proven, and end up as
+	 * 		narrow enclosures that aren't unique.
+	 * 
+	 */
+	template<typename F>
+	std::vector<RootEnclosure> roots_interval(F &&fx, double lower, double upper, const Options &opts = Options())
+	{
+		std::vector<RootEnclosure> found;
+		std::vector<RootEnclosure> pending(1, RootEnclosure{Interval(lower, upper), false});
+		std::size_t evaluations = 0;
+		while(!pending.empty())
+		{
+			RootEnclosure box = pending.back();
+			pending.pop_back();
+			const Interval x = box.bounds;
+			double m = x.mid();
+			bool narrow = x.width() <= std::max(opts.abs_tol, opts.rel_tol * x.magnitude()) || m <= x.lower() || m >= x.upper();
+			if(evaluations >= opts.max_evaluations)
+			{
+				found.push_back(box);
+				continue;
+			}
+
+			Jet<1, Interval> f = fx(Jet<1, Interval>::variable(x));
+			++evaluations;
+			if(!f[0].contains(0))
+			{
+				continue;
+			}
+			if(narrow)
+			{
+				found.push_back(box);
+				continue;
+			}
+			if(f[1].contains(0))
+			{
+				pending.push_back({Interval(m, x.upper()), false});
+				pending.push_back({Interval(x.lower(), m), false});
+				continue;
+			}
+
+			Interval fm = fx(Interval(m));
+			++evaluations;
+			Interval newton = m - fm / f[1];
+			Interval next = intersect(x, newton);
+			if(next.empty())
+			{
+				continue;
+			}
+			bool unique = box.unique || x.interior(newton);
+			if(next.width() >= x.width())
+			{
+				//Newton stalled; the box is as narrow as it gets, or needs splitting before it can shrink.
+				if(unique)
+				{
+					found.push_back({next, true});
+				}
+				else
+				{
+					pending.push_back({Interval(m, x.upper()), false});
+					pending.push_back({Interval(x.lower(), m), false});
+				}
+				continue;
+			}
+			pending.push_back({next, unique});
+		}
+
+		//Bisection can leave a root on the edge of two neighbouring boxes, so merge any that touch.
+		std::sort(found.begin(), found.end(), [](const RootEnclosure &a, const RootEnclosure &b){
+			return a.bounds.lower() < b.bounds.lower();
+		});
+		std::vector<RootEnclosure> merged;
+		for(const RootEnclosure &root : found)
+		{
+			if(!merged.empty() && root.bounds.lower() <= merged.back().bounds.upper())
+			{
+				merged.back().bounds = hull(merged.back().bounds, root.bounds);
+				merged.back().unique = false;
+			}
+			else
+			{
+				merged.push_back(root);
+			}
+		}
+		return merged;
+	}
+
+	namespace detail
+	{
+		/**
+		 * @brief A piece of integral_verified()'s integration interval, and the enclosure of the integral over it.
+		 * 
+		 */
+		struct VerifiedPanel
+		{
+			double lower;
+			double upper;
+			Interval value;
+		};
+
+		/**
+		 * @brief Encloses the integral over one panel, by integrating the Taylor polynomial around its midpoint term by term.
+		 * 
+		 * @remarks With x = m + t for |t| <= h, the odd terms integrate to 0 and c_k t^k to 2 c_k h^(k+1) / (k+1). The remainder
+		 * 		c_Order(xi) t^Order doesn't change sign for an even Order, so it integrates into c_Order(X) 2 h^(Order+1) / (Order+1),
+		 * 		with c_Order(X) enclosing the coefficient over the whole panel.
+		 * 
+		 */
+		template<std::size_t Order, typename F>
+		void verified_panel(F &fx, VerifiedPanel &panel)
+		{
+			Interval x(panel.lower, panel.upper);
+			Interval m = (Interval(panel.lower) + Interval(panel.upper)) / 2;
+			Interval h = (Interval(panel.upper) - Interval(panel.lower)) / 2;
+			Jet<Order, Interval> center = fx(Jet<Order, Interval>::variable(m));
+			Jet<Order, Interval> whole = fx(Jet<Order, Interval>::variable(x));
+			Interval power = h;
+			Interval sum = 0;
+			for(std::size_t k = 0; k <= Order; ++k)
+			{
+				if(k % 2 == 0)
+				{
+					sum += (k == Order ? whole[k] : center[k]) * power * 2 / double(k + 1);
+				}
+				power *= h;
+			}
+			panel.value = sum;
+		}
+	}
+
+	/**
+	 * @brief Encloses a definite integral between guaranteed bounds.
+	 * 
+	 * @tparam Order The (even) order of the Taylor model on each panel.
+	 * @param fx A template/generic callable, evaluated on Jet<Order, Interval>. It has to be smooth on [lower, upper].
+	 * @param lower The lower bound. It has to be finite.
+	 * @param upper The upper bound. It has to be finite.
+	 * @param opts The target width of the enclosure, from rel_tol and abs_tol, and the evaluation budget.
+	 * @return Interval Contains the exact integral.
+	 * 
+	 * @remarks The panel with the widest enclosure is bisected until the enclosures add up to the target width.
+	 * 		Each panel costs 2 evaluations, and its width shrinks like h^(Order+2).
+	 * 
+	 */
+	template<std::size_t Order = 4, typename F>
+	Interval integral_verified(F &&fx, double lower, double upper, const Options &opts = Options())
+	{
+		static_assert(Order % 2 == 0, "The remainder of the Taylor model only has a fixed sign for even orders.");
+		if(lower > upper)
+		{
+			return -integral_verified<Order>(fx, upper, lower, opts);
+		}
+		if(!std::isfinite(lower) || !std::isfinite(upper))
+		{
+			return Interval::entire();
+		}
+		//Widest on top. A NaN width (a NaN bound, from fx) ranks with the infinite ones, so it surfaces and stops the loop.
+		auto rank = [](const detail::VerifiedPanel &panel)->double{
+			double w = panel.value.width();
+			return std::isnan(w) ? INF : w;
+		};
+		auto byWidth = [&](const detail::VerifiedPanel &a, const detail::VerifiedPanel &b)->bool{
+			return rank(a) < rank(b);
+		};
+		std::vector<detail::VerifiedPanel> heap(1, detail::VerifiedPanel{lower, upper, Interval()});
+		detail::verified_panel<Order>(fx, heap[0]);
+		std::size_t evaluations = 2;
+		//Running totals for the stopping test only; the result is re-summed with outward rounding.
+		double width = heap[0].value.width();
+		double value = heap[0].value.mid();
+		while(!(width <= std::max(opts.abs_tol, opts.rel_tol * std::abs(value))) && evaluations + 4 <= opts.max_evaluations)
+		{
+			std::pop_heap(heap.begin(), heap.end(), byWidth);
+			detail::VerifiedPanel parent = heap.back();
+			heap.pop_back();
+			if(std::isnan(parent.value.width()))
+			{
+				//Nothing is known about this panel, and bisecting it won't change that.
+				return Interval::entire();
+			}
+			double mid = parent.lower + (parent.upper - parent.lower) / 2;
+			if(mid <= parent.lower || mid >= parent.upper)
+			{
+				//Can't be split any further.
+				heap.push_back(parent);
+				std::push_heap(heap.begin(), heap.end(), byWidth);
+				break;
+			}
+			detail::VerifiedPanel children[2] = {{parent.lower, mid, Interval()}, {mid, parent.upper, Interval()}};
+			width -= parent.value.width();
+			value -= parent.value.mid();
+			for(detail::VerifiedPanel &child : children)
+			{
+				detail::verified_panel<Order>(fx, child);
+				evaluations += 2;
+				width += child.value.width();
+				value += child.value.mid();
+				heap.push_back(child);
+				std::push_heap(heap.begin(), heap.end(), byWidth);
+			}
+			//Unbounded panels (near a singularity, say) poison the running totals, so start them over.
+			if(!std::isfinite(width) || !std::isfinite(value))
+			{
+				width = 0;
+				value = 0;
+				for(const detail::VerifiedPanel &panel : heap)
+				{
+					width += panel.value.width();
+					value += panel.value.mid();
+				}
+			}
+		}
+
+		Interval ret = 0;
+		for(const detail::VerifiedPanel &panel : heap)
+		{
+			ret += panel.value;
+		}
+		return ret;
+	}
+
+	//////////////////////////CUBATURE/////////////////////////////
+
+	namespace detail
+	{
+		/**
+		 * @brief A set of threads that stay up between parallel loops, so a loop doesn't pay for starting and joining them.
+		 * 
+		 * @remarks The calling thread works too, so a pool of n threads starts n - 1 of them.
+		 * 		One loop runs at a time: run() from a second thread, or from inside a loop's own body, declines instead of waiting.
+		 * 
+		 */
+		class ThreadPool
+		{
+		public:
+			/**
+			 * @brief Starts the threads.
+			 * 
+			 * @param threads The amount of threads, counting the one that calls run(), or 0 for one per hardware thread.
+			 * 		Fewer start if the system runs out.
+			 */
+			explicit ThreadPool(unsigned threads)
+			{
+				if(threads == 0)
+				{
+					threads = std::max(1u, std::thread::hardware_concurrency());
+				}
+				mErrors.resize(threads);
+				try
+				{
+					for(unsigned t = 1; t < threads; ++t)
+					{
+						mWorkers.emplace_back(&ThreadPool::mWork, this, t);
+					}
+				}
+				catch(const std::system_error &)
+				{
+					//Out of threads: make do with the ones that did start.
+				}
+			}
+
+			ThreadPool(const ThreadPool &) = delete;
+			ThreadPool &operator=(const ThreadPool &) = delete;
+
+			~ThreadPool()
+			{
+				{
+					std::lock_guard<std::mutex> lock(mMutex);
+					mStop = true;
+				}
+				mWake.notify_all();
+				for(std::thread &worker : mWorkers)
+				{
+					worker.join();
+				}
+			}
+
+			/**
+			 * @brief The amount of threads, counting the calling one.
+			 * 
+			 */
+			unsigned size() const
+			{
+				return unsigned(mWorkers.size()) + 1;
+			}
+
+			/**
+			 * @brief Runs body(i) for every i in [0, count) on at most threads of the pool's threads, the calling one included.
+			 * 
+			 * @return bool Whether it ran; false, without running anything, if the pool is already running a loop.
+			 * 
+			 * @remarks Indices are handed out dynamically. If body throws, no more indices are handed out,
+			 * 		and once every thread has stopped the first exception is rethrown.
+			 * 
+			 */
+			bool run(std::size_t count, unsigned threads, const std::function<void(std::size_t)> &body)
+			{
+				std::unique_lock<std::mutex> busy(mBusy, std::try_to_lock);
+				if(!busy.owns_lock())
+				{
+					return false;
+				}
+				{
+					std::lock_guard<std::mutex> lock(mMutex);
+					mBody = &body;
+					mCount = count;
+					mNext = 0;
+					mLimit = threads;
+					mActive = unsigned(mWorkers.size());
+					std::fill(mErrors.begin(), mErrors.end(), std::exception_ptr());
+					++mGeneration;
+				}
+				mWake.notify_all();
+				mDrain(0);
+				{
+					std::unique_lock<std::mutex> lock(mMutex);
+					mDone.wait(lock, [this]{ return mActive == 0; });
+				}
+				for(const std::exception_ptr &error : mErrors)
+				{
+					if(error)
+					{
+						std::rethrow_exception(error);
+					}
+				}
+				return true;
+			}
+
+		private:
+			std::vector<std::thread> mWorkers;
+			//Held for as long as a loop runs.
+			std::mutex mBusy;
+			//Guards everything below that isn't atomic, and wakes the workers for a loop and the caller once they're done.
+			std::mutex mMutex;
+			std::condition_variable mWake;
+			std::condition_variable mDone;
+			const std::function<void(std::size_t)> *mBody = nullptr;
+			std::size_t mCount = 0;
+			std::atomic<std::size_t> mNext{0};
+			unsigned mLimit = 0;
+			unsigned mActive = 0;
+			std::uint64_t mGeneration = 0;
+			bool mStop = false;
+			//An exception can't leave a std::thread, so each one keeps its own for the caller to rethrow.
+			std::vector<std::exception_ptr> mErrors;
+
+			void mWork(unsigned t)
+			{
+				std::uint64_t seen = 0;
+				for(;;)
+				{
+					{
+						std::unique_lock<std::mutex> lock(mMutex);
+						mWake.wait(lock, [&]{ return mStop || mGeneration != seen; });
+						if(mStop)
+						{
+							return;
+						}
+						seen = mGeneration;
+					}
+					mDrain(t);
+					std::lock_guard<std::mutex> lock(mMutex);
+					if(--mActive == 0)
+					{
+						mDone.notify_one();
+					}
+				}
+			}
+
+			void mDrain(unsigned t)
+			{
+				if(t >= mLimit)
+				{
+					return;
+				}
+				try
+				{
+					for(std::size_t i = mNext++; i < mCount; i = mNext++)
+					{
+						(*mBody)(i);
+					}
+				}
+				catch(...)
+				{
+					mErrors[t] = std::current_exception();
+					mNext = mCount;
+				}
+			}
+		};
+
+		/**
+		 * @brief The pool parallel_for() uses when it isn't given one: one thread per hardware thread,
+		 * 		started the first time it's needed and kept until the program exits.
+		 * 
+		 */
+		inline ThreadPool &shared_pool()
+		{
+			static ThreadPool pool(0);
+			return pool;
+		}
+
+		/**
+		 * @brief Runs body(i) for every i in [0, count), spread over a set of threads.
+		 * 
+		 * @param count The amount of indices.
+		 * @param threads The amount of threads to use, or 0 for one per hardware thread.
+		 * @param body The work for a single index. It must only write to state owned by that index.
+		 * @param pool The threads to run on, or null for shared_pool(). At most its size() of them run.
+		 * 
+		 * @remarks Indices are handed out dynamically, so the results are only deterministic if each one is stored by index.
+		 * 		If body throws, no more indices are handed out, and once every thread has stopped the first exception is rethrown.
+		 * 		If the pool is busy, from another thread or because this loop is nested inside one of its own, the loop starts
+		 * 		threads of its own instead, and joins them when it's done.
+		 * 
+		 */
+		inline void parallel_for(std::size_t count, unsigned threads, std::function<void(std::size_t)> body, ThreadPool *pool = nullptr)
+		{
+			if(threads == 0)
+			{
+				threads = std::max(1u, std::thread::hardware_concurrency());
+			}
+			threads = unsigned(std::min<std::size_t>(threads, count));
+			if(threads <= 1)
+			{
+				for(std::size_t i = 0; i < count; ++i)
+				{
+					body(i);
+				}
+				return;
+			}
+			if(!pool)
+			{
+				pool = &shared_pool();
+			}
+			if(pool->run(count, threads, body))
+			{
+				return;
+			}
+
+			std::atomic<std::size_t> next(0);
+			std::vector<std::exception_ptr> errors(threads);
+			auto worker = [&](unsigned t){
+				try
+				{
+					for(std::size_t i = next++; i < count; i = next++)
+					{
+						body(i);
+					}
+				}
+				catch(...)
+				{
+					errors[t] = std::current_exception();
+					next = count;
+				}
+			};
+			std::vector<std::thread> workers;
+			try
+			{
+				for(unsigned t = 1; t < threads; ++t)
+				{
+					workers.emplace_back(worker, t);
+				}
+			}
+			catch(const std::system_error &)
+			{
+				//Out of threads: the ones that did start, and this one, share the work.
+			}
+			worker(0);
+			for(auto &thread : workers)
+			{
+				thread.join();
+			}
+			for(const std::exception_ptr &error : errors)
+			{
+				if(error)
+				{
+					std::rethrow_exception(error);
+				}
+			}
+		}
+
+		/**
+		 * @brief A hyper-rectangle of an adaptive cubature, along with its rule's estimate.
+		 * 
+		 */
+		struct CubatureRegion
+		{
+			std::vector<double> center;
+			std::vector<double> halfwidth;
+			double value;
+			double error;
+			//The axis with the largest fourth difference, which is the one to bisect next.
+			std::size_t split;
+		};
+
+		/**
+		 * @brief Applies the degree 7 Genz-Malik rule to a region, with its embedded degree 5 rule for the error.
+		 * 
+		 * @return std::size_t The amount of function evaluations, 1 + 4n + 2n(n-1) + 2^n.
+		 * 
+		 */
+		inline std::size_t genz_malik(const FuncN &fx, CubatureRegion &region)
+		{
+			const double lambda2 = std::sqrt(9.0 / 70.0);
+			const double lambda4 = std::sqrt(9.0 / 10.0);
+			const double lambda5 = std::sqrt(9.0 / 19.0);
+			const double ratio = (lambda2 * lambda2) / (lambda4 * lambda4);
+			const std::size_t n = region.center.size();
+			const double dn = double(n);
+
+			const double weight1 = (12824.0 - 9120.0 * dn + 400.0 * dn * dn) / 19683.0;
+			const double weight2 = 980.0 / 6561.0;
+			const double weight3 = (1820.0 - 400.0 * dn) / 19683.0;
+			const double weight4 = 200.0 / 19683.0;
+			const double weight5 = 6859.0 / 19683.0 / std::ldexp(1.0, int(n));
+			const double weightE1 = (729.0 - 950.0 * dn + 50.0 * dn * dn) / 729.0;
+			const double weightE2 = 245.0 / 486.0;
+			const double weightE3 = (265.0 - 100.0 * dn) / 1458.0;
+			const double weightE4 = 25.0 / 729.0;
+
+			std::vector<double> x = region.center;
+			const std::vector<double> &c = region.center;
+			const std::vector<double> &h = region.halfwidth;
+			double volume = 1;
+			for(std::size_t i = 0; i < n; ++i)
+			{
+				volume *= 2 * h[i];
+			}
+
+			double f0 = fx(x);
+			double sum2 = 0;
+			double sum3 = 0;
+			double widest = -1;
+			region.split = 0;
+			for(std::size_t i = 0; i < n; ++i)
+			{
+				x[i] = c[i] + lambda2 * h[i];
+				double a = fx(x);
+				x[i] = c[i] - lambda2 * h[i];
+				double b = fx(x);
+				x[i] = c[i] + lambda4 * h[i];
+				double d = fx(x);
+				x[i] = c[i] - lambda4 * h[i];
+				double e = fx(x);
+				x[i] = c[i];
+				sum2 += a + b;
+				sum3 += d + e;
+				double diff = std::abs(a + b - 2 * f0 - ratio * (d + e - 2 * f0));
+				//Ties go to the wider axis.
+				if(diff > widest || (diff == widest && h[i] > h[region.split]))
+				{
+					widest = diff;
+					region.split = i;
+				}
+			}
+
+			double sum4 = 0;
+			for(std::size_t i = 0; i + 1 < n; ++i)
+			{
+				for(std::size_t j = i + 1; j < n; ++j)
+				{
+					for(int signs = 0; signs < 4; ++signs)
+					{
+						x[i] = c[i] + ((signs & 1) ? (-lambda4) : (lambda4)) * h[i];
+						x[j] = c[j] + ((signs & 2) ? (-lambda4) : (lambda4)) * h[j];
+						sum4 += fx(x);
+					}
+					x[i] = c[i];
+					x[j] = c[j];
+				}
+			}
+
+			double sum5 = 0;
+			for(std::size_t corner = 0; corner < (std::size_t(1) << n); ++corner)
+			{
+				for(std::size_t i = 0; i < n; ++i)
+				{
+					x[i] = c[i] + (((corner >> i) & 1) ? (-lambda5) : (lambda5)) * h[i];
+				}
+				sum5 += fx(x);
+			}
+
+			double degree7 = volume * (weight1 * f0 + weight2 * sum2 + weight3 * sum3 + weight4 * sum4 + weight5 * sum5);
+			double degree5 = volume * (weightE1 * f0 + weightE2 * sum2 + weightE3 * sum3 + weightE4 * sum4);
+			region.value = degree7;
+			region.error = std::abs(degree7 - degree5);
+			return 1 + 4 * n + 2 * n * (n - 1) + (std::size_t(1) << n);
+		}
+	}
+
+	/**
+	 * @brief Adaptive cubature of a function of several variables over a hyper-rectangle.
+	 * 
+	 * @param fx The function to integrate. With opts.threads other than 1, it's called from several threads at once,
+	 * 		so it must be thread-safe.
+	 * @param lower The lower corner of the hyper-rectangle.
+	 * @param upper The upper corner of the hyper-rectangle.
+	 * @param opts Error targets, evaluation budget (the estimate so far is returned once it runs out) and threads.
+	 * @return Estimate The integral.
+	 * 
+	 * @remarks Regions with the largest error are bisected along their roughest axis, as judged by
+	 * 		the rule's fourth differences. The regions picked each round don't depend on the thread count,
+	 * 		so neither does the result. Every region costs 2^n corner evaluations, so this is meant for 2 to ~10 dimensions.
+	 * 
+	 */
+	inline Estimate integral_cubature(FuncN fx, const std::vector<double> &lower, const std::vector<double> &upper,
+							   const Options &opts = Options())
+	{
+		const double rel_tol = opts.rel_tol;
+		const double abs_tol = opts.abs_tol;
+		const std::size_t max_evaluations = opts.max_evaluations;
+		const std::size_t n = std::min(lower.size(), upper.size());
+		auto byError = [](const detail::CubatureRegion &a, const detail::CubatureRegion &b)->bool{
+			return a.error < b.error;
+		};
+
+		detail::CubatureRegion first;
+		for(std::size_t i = 0; i < n; ++i)
+		{
+			first.center.push_back((lower[i] + upper[i]) / 2);
+			first.halfwidth.push_back((upper[i] - lower[i]) / 2);
+		}
+		if(n == 0)
+		{
+			return {fx(first.center), 0, 1};
+		}
+
+		Estimate est = {0, 0, 0};
+		est.evaluations = detail::genz_malik(fx, first);
+		const std::size_t cost = est.evaluations;
+		//A max-heap of every region, worst error on top.
+		std::vector<detail::CubatureRegion> heap;
+		heap.push_back(first);
+		double value = first.value;
+		double error = first.error;
+
+		//At most this many regions are bisected per round, so each round has work for the threads.
+		const std::size_t batch = 64;
+		while(error > std::max(abs_tol, rel_tol * std::abs(value)) && est.evaluations + 2 * cost <= max_evaluations)
+		{
+			//Pop the worst regions until what's left would meet the target on its own.
+			std::vector<detail::CubatureRegion> parents;
+			double remaining = error;
+			while(!heap.empty() && parents.size() < batch
+				  && est.evaluations + 2 * cost * (parents.size() + 1) <= max_evaluations
+				  && (parents.empty() || remaining > std::max(abs_tol, rel_tol * std::abs(value))))
+			{
+				std::pop_heap(heap.begin(), heap.end(), byError);
+				parents.push_back(heap.back());
+				heap.pop_back();
+				remaining -= parents.back().error;
+			}
+
+			std::vector<detail::CubatureRegion> children;
+			for(const detail::CubatureRegion &parent : parents)
+			{
+				detail::CubatureRegion child = parent;
+				child.halfwidth[parent.split] /= 2;
+				child.center[parent.split] = parent.center[parent.split] - child.halfwidth[parent.split];
+				children.push_back(child);
+				child.center[parent.split] = parent.center[parent.split] + child.halfwidth[parent.split];
+				children.push_back(child);
+				value -= parent.value;
+				error -= parent.error;
+			}
+
+			detail::parallel_for(children.size(), opts.threads, [&](std::size_t i){
+				detail::genz_malik(fx, children[i]);
+			});
+
+			for(const detail::CubatureRegion &child : children)
+			{
+				est.evaluations += cost;
+				value += child.value;
+				error += child.error;
+				heap.push_back(child);
+				std::push_heap(heap.begin(), heap.end(), byError);
+			}
+		}
+
+		//Re-sum from scratch, rather than trusting the running totals' cancellation.
+		for(const detail::CubatureRegion &region : heap)
+		{
+			est.value += region.value;
+			est.error += region.error;
+		}
+		return est;
+	}
+
+	//////////////////////////QUASI-MONTE CARLO/////////////////////////////
+
+	/**
+	 * @brief Sobol low-discrepancy sequence, in Gray-code order, with Joe & Kuo's direction numbers.
+	 * 
+	 */
+	class SobolSequence
+	{
+	public:
+		/**
+		 * @brief The most dimensions there are direction numbers for.
+		 * 
+		 */
+		static const unsigned MAX_DIMENSION = 21;
+
+		/**
+		 * @brief Constructor.
+		 * 
+		 * @param dimension The dimension of the points, at most MAX_DIMENSION.
+		 * 
+		 */
+		explicit SobolSequence(unsigned dimension)
+			: mDirections(std::size_t(dimension) * BITS), mShift(dimension, 0), mPoint(dimension, 0), mIndex(0)
+		{
+			//Degree s, interior coefficients a, and initial m_1..m_s, for dimensions 2 through 21.
+			static const unsigned table[MAX_DIMENSION - 1][9] = {
+				{1, 0, 1}, {2, 1, 1, 3}, {3, 1, 1, 3, 1}, {3, 2, 1, 1, 1}, {4, 1, 1, 1, 3, 3},
+				{4, 4, 1, 3, 5, 13}, {5, 2, 1, 1, 5, 5, 17}, {5, 4, 1, 1, 5, 5, 5}, {5, 7, 1, 1, 7, 11, 19},
+				{5, 11, 1, 1, 5, 1, 1}, {5, 13, 1, 1, 1, 3, 11}, {5, 14, 1, 3, 5, 5, 31},
+				{6, 1, 1, 3, 3, 9, 7, 49}, {6, 13, 1, 1, 1, 15, 21, 21}, {6, 16, 1, 3, 1, 13, 27, 49},
+				{6, 19, 1, 1, 1, 15, 7, 5}, {6, 22, 1, 3, 1, 15, 13, 25}, {6, 25, 1, 1, 5, 5, 19, 61},
+				{7, 1, 1, 3, 7, 11, 23, 15, 103}, {7, 4, 1, 3, 7, 13, 13, 15, 69}
+			};
+			if(dimension == 0 || dimension > MAX_DIMENSION)
+			{
+				throw std::invalid_argument("SobolSequence: dimension must be between 1 and MAX_DIMENSION");
+			}
+			//The first dimension is the van der Corput sequence.
+			for(unsigned i = 0; i < BITS; ++i)
+			{
+				mDirections[i] = std::uint64_t(1) << (BITS - 1 - i);
+			}
+			for(unsigned d = 1; d < dimension; ++d)
+			{
+				const unsigned *row = table[d - 1];
+				unsigned degree = row[0];
+				unsigned a = row[1];
+				std::uint64_t *v = &mDirections[std::size_t(d) * BITS];
+				for(unsigned i = 0; i < BITS; ++i)
+				{
+					if(i < degree)
+					{
+						v[i] = std::uint64_t(row[2 + i]) << (BITS - 1 - i);
+					}
+					else
+					{
+						v[i] = v[i - degree] ^ (v[i - degree] >> degree);
+						for(unsigned k = 1; k < degree; ++k)
+						{
+							if((a >> (degree - 1 - k)) & 1)
+							{
+								v[i] ^= v[i - k];
+							}
+						}
+					}
+				}
+			}
+		}
+
+		/**
+		 * @brief Applies a random digital shift, so independent scramblings give an error estimate.
+		 * 
+		 * @param seed Seed of the shift. The same seed always gives the same sequence.
+		 * 
+		 */
+		void scramble(std::uint64_t seed)
+		{
+			std::mt19937_64 rng(seed);
+			for(std::size_t d = 0; d < mShift.size(); ++d)
+			{
+				std::uint64_t shift = rng();
+				mPoint[d] ^= mShift[d] ^ shift;
+				mShift[d] = shift;
+			}
+		}
+
+		/**
+		 * @brief Jumps straight to a point of the sequence, in O(dimension * log(index)).
+		 * 
+		 * @param index The index of the point to be returned by the next call to next().
+		 * 
+		 */
+		void seek(std::uint64_t index)
+		{
+			std::uint64_t gray = index ^ (index >> 1);
+			for(std::size_t d = 0; d < mPoint.size(); ++d)
+			{
+				std::uint64_t x = mShift[d];
+				for(unsigned bit = 0; bit < BITS && (gray >> bit) != 0; ++bit)
+				{
+					if((gray >> bit) & 1)
+					{
+						x ^= mDirections[d * BITS + bit];
+					}
+				}
+				mPoint[d] = x;
+			}
+			mIndex = index;
+		}
+
+		/**
+		 * @brief Writes the current point into out, then steps to the next one.
+		 * 
+		 * @param out Receives dimension() coordinates in [0, 1), starting at out[0].
+		 * 
+		 */
+		void next(double *out)
+		{
+			for(std::size_t d = 0; d < mPoint.size(); ++d)
+			{
+				out[d] = double(mPoint[d] >> 11) * 0x1p-53;
+			}
+			//Consecutive Gray codes differ in a single bit: the lowest zero bit of the index.
+			unsigned bit = 0;
+			while((mIndex >> bit) & 1)
+			{
+				++bit;
+			}
+			for(std::size_t d = 0; d < mPoint.size(); ++d)
+			{
+				mPoint[d] ^= mDirections[d * BITS + bit];
+			}
+			++mIndex;
+		}
+
+		unsigned dimension() const
+		{
+			return unsigned(mPoint.size());
+		}
+
+	private:
+		static const unsigned BITS = 64;
+		std::vector<std::uint64_t> mDirections;
+		std::vector<std::uint64_t> mShift;
+		std::vector<std::uint64_t> mPoint;
+		std::uint64_t mIndex;
+	};
+
+	/**
+	 * @brief Halton low-discrepancy sequence, using the first primes as bases. Any dimension works, but quality drops past ~20.
+	 * 
+	 */
+	class HaltonSequence
+	{
+	public:
+		/**
+		 * @brief Constructor.
+		 * 
+		 * @param dimension The dimension of the points.
+		 * 
+		 */
+		explicit HaltonSequence(unsigned dimension)
+			: mShift(dimension, 0), mIndex(0)
+		{
+			for(unsigned candidate = 2; mBases.size() < dimension; ++candidate)
+			{
+				bool prime = true;
+				for(unsigned b : mBases)
+				{
+					if(b * b > candidate)
+					{
+						break;
+					}
+					if(candidate % b == 0)
+					{
+						prime = false;
+						break;
+					}
+				}
+				if(prime)
+				{
+					mBases.push_back(candidate);
+				}
+			}
+		}
+
+		/**
+		 * @brief Applies a random Cranley-Patterson rotation, so independent scramblings give an error estimate.
+		 * 
+		 * @param seed Seed of the rotation.
+		 * 
+		 */
+		void scramble(std::uint64_t seed)
+		{
+			std::mt19937_64 rng(seed);
+			for(double &shift : mShift)
+			{
+				shift = double(rng() >> 11) * 0x1p-53;
+			}
+		}
+
+		/**
+		 * @brief Jumps straight to a point of the sequence.
+		 * 
+		 * @param index The index of the point to be returned by the next call to next().
+		 * 
+		 */
+		void seek(std::uint64_t index)
+		{
+			mIndex = index;
+		}
+
+		/**
+		 * @brief Writes the current point into out, then steps to the next one.
+		 * 
+		 * @param out Receives dimension() coordinates in [0, 1), starting at out[0].
+		 * 
+		 */
+		void next(double *out)
+		{
+			for(std::size_t d = 0; d < mBases.size(); ++d)
+			{
+				//Radical inverse of the index in this dimension's base.
+				double inverse = 0;
+				double scale = 1.0 / mBases[d];
+				for(std::uint64_t n = mIndex; n > 0; n /= mBases[d])
+				{
+					inverse += (n % mBases[d]) * scale;
+					scale /= mBases[d];
+				}
+				inverse += mShift[d];
+				out[d] = inverse - std::floor(inverse);
+			}
+			++mIndex;
+		}
+
+		unsigned dimension() const
+		{
+			return unsigned(mBases.size());
+		}
+
+	private:
+		std::vector<unsigned> mBases;
+		std::vector<double> mShift;
+		std::uint64_t mIndex;
+	};
+
+	/**
+	 * @brief The low-discrepancy sequences integral_qmc() can use.
+	 * 
+	 */
+	enum class Sequence
+	{
+		Sobol,
+		Halton
+	};
+
+	namespace detail
+	{
+		/**
+		 * @brief Sums one block of a scrambled sequence through a batched integrand.
+		 * 
+		 */
+		template<typename Generator>
+		double qmc_block(Generator gen, const BatchFuncN &fx, const std::vector<double> &lower,
+						 const std::vector<double> &upper, std::uint64_t first, std::size_t count)
+		{
+			const std::size_t n = lower.size();
+			std::vector<double> points(count * n);
+			std::vector<double> values(count);
+			gen.seek(first);
+			for(std::size_t i = 0; i < count; ++i)
+			{
+				double *point = &points[i * n];
+				gen.next(point);
+				for(std::size_t d = 0; d < n; ++d)
+				{
+					point[d] = lower[d] + point[d] * (upper[d] - lower[d]);
+				}
+			}
+			fx(points, values);
+			KahanSum<double> sum;
+			for(std::size_t i = 0; i < count; ++i)
+			{
+				sum.add(values[i]);
+			}
+			return sum.sum();
+		}
+	}
+
+	/**
+	 * @brief Randomized quasi-Monte Carlo integration over a hyper-rectangle, for when there are too many dimensions for integral_cubature().
+	 * 
+	 * @param fx The batched function to integrate. With opts.threads other than 1, blocks are evaluated from several threads at once,
+	 * 		so it must be thread-safe.
+	 * @param lower The lower corner of the hyper-rectangle.
+	 * @param upper The upper corner of the hyper-rectangle.
+	 * @param points The amount of points per replicate. Powers of 2 suit Sobol best.
+	 * @param replicates The amount of independently scrambled copies, which the error estimate comes from.
+	 * @param sequence The low-discrepancy sequence to use.
+	 * @param seed Seed of the scrambling.
+	 * @param opts The amount of threads.
+	 * @return Estimate The mean over the replicates, with their standard error as the error.
+	 * @throws std::invalid_argument If points is 0.
+	 * 
+	 * @remarks Each thread seeks straight to the start of its own block of the sequence. Blocks are a fixed size and are
+	 * 		reduced in order, so the result is bit-for-bit the same for any amount of threads.
+	 * 		Sobol only has direction numbers up to SobolSequence::MAX_DIMENSION, so past that Sobol silently uses Halton instead,
+	 * 		and the result is what Sequence::Halton would give.
+	 * 
+	 */
+	inline Estimate integral_qmc(BatchFuncN fx, const std::vector<double> &lower, const std::vector<double> &upper,
+						  std::size_t points = 1 << 16, unsigned replicates = 8, Sequence sequence = Sequence::Sobol,
+						  std::uint64_t seed = 1, const Options &opts = Options())
+	{
+		if(points == 0)
+		{
+			throw std::invalid_argument("integral_qmc: needs at least one point");
+		}
+		const std::size_t block = 1024;
+		const unsigned n = unsigned(std::min(lower.size(), upper.size()));
+		replicates = std::max(1u, replicates);
+		if(n > SobolSequence::MAX_DIMENSION)
+		{
+			sequence = Sequence::Halton;
+		}
+		double volume = 1;
+		for(unsigned d = 0; d < n; ++d)
+		{
+			volume *= upper[d] - lower[d];
+		}
+
+		std::size_t blocks = (points + block - 1) / block;
+		std::vector<double> sums(replicates * blocks);
+		detail::parallel_for(sums.size(), opts.threads, [&](std::size_t task){
+			std::uint64_t r = task / blocks;
+			std::uint64_t first = (task % blocks) * block;
+			std::size_t count = std::min<std::size_t>(block, points - first);
+			//Every replicate gets its own, reproducible scrambling.
+			std::uint64_t scramble = std::mt19937_64(seed * 0x9E3779B97F4A7C15ULL + r)();
+			if(sequence == Sequence::Sobol)
+			{
+				SobolSequence gen(n);
+				gen.scramble(scramble);
+				sums[task] = detail::qmc_block(gen, fx, lower, upper, first, count);
+			}
+			else
+			{
+				HaltonSequence gen(n);
+				gen.scramble(scramble);
+				sums[task] = detail::qmc_block(gen, fx, lower, upper, first, count);
+			}
+		});
+
+		std::vector<double> means(replicates);
+		detail::KahanSum<double> total;
+		for(unsigned r = 0; r < replicates; ++r)
+		{
+			detail::KahanSum<double> sum;
+			for(std::size_t b = 0; b < blocks; ++b)
+			{
+				sum.add(sums[r * blocks + b]);
+			}
+			means[r] = volume * sum.sum() / points;
+			total.add(means[r]);
+		}
+
+		Estimate est = {total.sum() / replicates, INF, points * replicates};
+		if(replicates > 1)
+		{
+			double variance = 0;
+			for(double mean : means)
+			{
+				variance += (mean - est.value) * (mean - est.value);
+			}
+			est.error = std::sqrt(variance / (replicates - 1) / replicates);
+		}
+		return est;
+	}
+
+	/**
+	 * @brief Randomized quasi-Monte Carlo integration of a point-at-a-time function.
+	 * 
+	 * @see integral_qmc(BatchFuncN, const std::vector<double>&, const std::vector<double>&, std::size_t, unsigned, Sequence, std::uint64_t, const Options&)
+	 * 
+	 */
+	inline Estimate integral_qmc(FuncN fx, const std::vector<double> &lower, const std::vector<double> &upper,
+						  std::size_t points = 1 << 16, unsigned replicates = 8, Sequence sequence = Sequence::Sobol,
+						  std::uint64_t seed = 1, const Options &opts = Options())
+	{
+		const std::size_t n = std::min(lower.size(), upper.size());
+		return integral_qmc([&](const std::vector<double> &batch, std::vector<double> &values){
+			std::vector<double> point(n);
+			for(std::size_t i = 0; i < values.size(); ++i)
+			{
+				std::copy(batch.begin() + i * n, batch.begin() + (i + 1) * n, point.begin());
+				values[i] = fx(point);
+			}
+		}, lower, upper, points, replicates, sequence, seed, opts);
+	}
+
+	//////////////////////////ODES/////////////////////////////
+
+	namespace detail
+	{
+		/**
+		 * @brief What the ODE solvers need to know about a state: a scalar, or a container of scalars like std::array or std::vector.
+		 * 
+		 */
+		template<typename State, bool = std::is_class<State>::value>
+		struct OdeState
+		{
+			typedef State scalar;
+
+			static std::size_t size(const State &)
+			{
+				return 1;
+			}
+
+			static scalar &at(State &y, std::size_t)
+			{
+				return y;
+			}
+
+			static const scalar &at(const State &y, std::size_t)
+			{
+				return y;
+			}
+		};
+
+		template<typename State>
+		struct OdeState<State, true>
+		{
+			typedef typename State::value_type scalar;
+
+			static std::size_t size(const State &y)
+			{
+				return y.size();
+			}
+
+			static scalar &at(State &y, std::size_t i)
+			{
+				return y[i];
+			}
+
+			static const scalar &at(const State &y, std::size_t i)
+			{
+				return y[i];
+			}
+		};
+
+		/**
+		 * @brief The coefficients of an explicit Runge-Kutta method, with its error estimate and interpolant.
+		 * 
+		 * @remarks Stage s is k[s] = f(t + c[s] h, y + h sum a[s][j] k[j]). Row `stages` of a is the step itself, so its stage is
+		 * 		f at the new point, which is also the first stage of the next step. The rows after it are extra stages for interpolating.
+		 * 		A step's error is estimated as h sum e[j] k[j], tempered by the third order estimate e3 for DOP853,
+		 * 		and the solution a fraction theta into the step is y + h sum w[j] k[j], with w[j] = sum dense[j][p] theta^(p+1).
+		 * 
+		 */
+		template<typename T>
+		struct RungeKuttaMethod
+		{
+			static const int MAX_STAGES = 19;
+			static const int MAX_DEGREE = 7;
+
+			int stages;		//Evaluations a step.
+			int extra;		//More evaluations to interpolate within a step.
+			int order;		//How fast the error estimate shrinks with the step, as h^order. 0 for no error estimate.
+			bool tempered;	//Whether e3 tempers the error estimate.
+			T c[MAX_STAGES];
+			T a[MAX_STAGES][MAX_STAGES];
+			T e[MAX_STAGES];
+			T e3[MAX_STAGES];
+			T dense[MAX_STAGES][MAX_DEGREE];
+		};
+
+		template<typename T>
+		RungeKuttaMethod<T> rk4_method()
+		{
+			RungeKuttaMethod<T> m = {};
+			m.stages = 4;
+			m.order = 0;
+			m.c[1] = m.c[2] = T(1) / 2;
+			m.c[3] = m.c[4] = 1;
+			m.a[1][0] = m.a[2][1] = T(1) / 2;
+			m.a[3][2] = 1;
+			const T b[4] = {T(1) / 6, T(1) / 3, T(1) / 3, T(1) / 6};
+			for(int j = 0; j < 4; ++j)
+			{
+				m.a[4][j] = b[j];
+				//Cubic Hermite from the ends: (3 theta^2 - 2 theta^3) of the step, plus the slopes at either end.
+				m.dense[j][1] = 3 * b[j];
+				m.dense[j][2] = -2 * b[j];
+			}
+			m.dense[0][0] += 1;
+			m.dense[0][1] -= 2;
+			m.dense[0][2] += 1;
+			m.dense[4][1] = -1;
+			m.dense[4][2] = 1;
+			return m;
+		}
+
+		template<typename T>
+		RungeKuttaMethod<T> dormand_prince_method()
+		{
+			RungeKuttaMethod<T> m = {};
+			m.stages = 6;
+			m.order = 5;
+			const T c[7] = {0, T(1) / 5, T(3) / 10, T(4) / 5, T(8) / 9, 1, 1};
+			const T a[7][6] = {
+				{0},
+				{T(1) / 5},
+				{T(3) / 40, T(9) / 40},
+				{T(44) / 45, T(-56) / 15, T(32) / 9},
+				{T(19372) / 6561, T(-25360) / 2187, T(64448) / 6561, T(-212) / 729},
+				{T(9017) / 3168, T(-355) / 33, T(46732) / 5247, T(49) / 176, T(-5103) / 18656},
+				{T(35) / 384, 0, T(500) / 1113, T(125) / 192, T(-2187) / 6784, T(11) / 84}
+			};
+			const T e[7] = {T(71) / 57600, 0, T(-71) / 16695, T(71) / 1920, T(-17253) / 339200, T(22) / 525, T(-1) / 40};
+			//Shampine's quartic interpolant.
+			const T dense[7][4] = {
+				{1, T(-8048581381) / 2820520608, T(8663915743) / 2820520608, T(-12715105075) / 11282082432},
+				{0, 0, 0, 0},
+				{0, T(131558114200) / 32700410799, T(-68118460800) / 10900136933, T(87487479700) / 32700410799},
+				{0, T(-1754552775) / 470086768, T(14199869525) / 1410260304, T(-10690763975) / 1880347072},
+				{0, T(127303824393) / 49829197408, T(-318862633887) / 49829197408, T(701980252875) / 199316789632},
+				{0, T(-282668133) / 205662961, T(2019193451) / 616988883, T(-1453857185) / 822651844},
+				{0, T(40617522) / 29380423, T(-110615467) / 29380423, T(69997945) / 29380423}
+			};
+			for(int i = 0; i < 7; ++i)
+			{
+				m.c[i] = c[i];
+				m.e[i] = e[i];
+				for(int j = 0; j < 6; ++j)
+				{
+					m.a[i][j] = a[i][j];
+				}
+				for(int p = 0; p < 4; ++p)
+				{
+					m.dense[i][p] = dense[i][p];
+				}
+			}
+			return m;
+		}
+
+		template<typename T>
+		RungeKuttaMethod<T> verner65_method()
+		{
+			RungeKuttaMethod<T> m = {};
+			m.stages = 8;
+			m.extra = 1;
+			m.order = 6;
+			//Verner's pair as DVERK has it, with the sixth order solution's stage at the end.
+			const T c[9] = {0, T(1) / 6, T(4) / 15, T(2) / 3, T(5) / 6, 1, T(1) / 15, 1, 1};
+			const T a[9][8] = {
+				{0},
+				{T(1) / 6},
+				{T(4) / 75, T(16) / 75},
+				{T(5) / 6, T(-8) / 3, T(5) / 2},
+				{T(-165) / 64, T(55) / 6, T(-425) / 64, T(85) / 96},
+				{T(12) / 5, -8, T(4015) / 612, T(-11) / 36, T(88) / 255},
+				{T(-8263) / 15000, T(124) / 75, T(-643) / 680, T(-81) / 250, T(2484) / 10625, 0},
+				{T(3501) / 1720, T(-300) / 43, T(297275) / 52632, T(-319) / 2322, T(24068) / 84065, 0, T(3850) / 26703},
+				{T(3) / 40, 0, T(875) / 2244, T(23) / 72, T(264) / 1955, 0, T(125) / 11592, T(43) / 616}
+			};
+			//The sixth order solution less the fifth order one.
+			const T e[8] = {T(-1) / 160, 0, T(-125) / 17952, T(1) / 144, T(-12) / 1955, T(-3) / 44, T(125) / 11592, T(43) / 616};
+			for(int i = 0; i < 9; ++i)
+			{
+				m.c[i] = c[i];
+				for(int j = 0; j < 8; ++j)
+				{
+					m.a[i][j] = a[i][j];
+				}
+			}
+			for(int j = 0; j < 8; ++j)
+			{
+				m.e[j] = e[j];
+			}
+
+			/*
+			DVERK's own interpolant is only fourth order. One more stage, halfway through the step and fourth order accurate there,
+			makes it fifth order: w[j] = sum d[p][j] theta^(p+1), which matches the step and its slope at theta = 1.
+			*/
+			struct Entry
+			{
+				int i;
+				int j;
+				long double value;
+			};
+			static const Entry extra[] = {
+				{9, 0, -8.03214608546261343188267422574e-4L}, {9, 2, 3.07616997389768800312634099207e-1L}, {9, 3, 7.54195954939326889818518669386e-2L},
+				{9, 4, -1.50362062684360116399333320842e-2L}, {9, 5, -3.51020830791990550865264801193e-3L}, {9, 6, 1.36696699003011692921387351112e-1L},
+				{9, 7, -2.75758673004035004241276668074e-3L}, {9, 8, 2.37392402822934631831369694094e-3L}
+			};
+			static const Entry d[] = {
+				{0, 0, 9.94390522391032658550312731007e-1L}, {0, 2, -6.24941801355541605357316064332e-3L}, {0, 3, 6.23275289885260161076363221493e-3L},
+				{0, 4, -5.50905217862777267693071942067e-3L}, {0, 5, -6.11943011887346339965883890193e-2L}, {0, 6, 9.67818773113758014093731710393e-3L},
+				{0, 7, 6.26513083598949824250785887579e-2L}, {1, 0, -4.25858166779743912566764519012L}, {1, 2, 8.5688706909565072129371154299L},
+				{1, 3, 3.20397963088604347296405021124L}, {1, 4, 6.66763784055711958423591424537e-1L}, {1, 5, -9.36181941538813709197657104013e-2L},
+				{1, 6, 3.1673855727646502013051275038e-1L}, {1, 7, 9.58471987765928321321410844585e-2L}, {1, 8, -5.0e-1L},
+				{1, 9, -8.0L}, {2, 0, 7.97003782204305168936059587913L}, {2, 2, -2.49888170431784183496428299029e1L},
+				{2, 3, -1.27444864689367240992895509768e1L}, {2, 4, -4.08057666581961164011644803687L}, {2, 5, -3.26860123166708843338954045902e-1L},
+				{2, 6, -7.67836131889323135542781019886e-1L}, {2, 7, -1.06146138905226562143003189673L}, {2, 8, 4.0L},
+				{2, 9, 3.2e1L}, {3, 0, -6.76689273025791663591950711192L}, {3, 2, 2.62456631793026775446529555349e1L},
+				{3, 3, 1.74493252558421295954661190132e1L}, {3, 4, 6.85809000404337598927598278523L}, {3, 5, 1.17935203355000033542355877909L},
+				{3, 6, 6.00660335158586328363538840437e-1L}, {3, 7, 1.93380192236114684273735215907L}, {3, 8, -7.5L},
+				{3, 9, -4.0e1L}, {4, 0, 2.13604605362127141367624369191L}, {4, 2, -9.42953871031498282790079802595L},
+				{4, 3, -7.59560672624585712630693743545L}, {4, 4, -3.30372970692949303618496783199L}, {4, 5, -6.97679415040675487168250633763e-1L},
+				{4, 6, -1.48457649450088705445555023991e-1L}, {4, 7, -9.61033845640174230669734740758e-1L}, {4, 8, 4.0L},
+				{4, 9, 1.6e1L}
+			};
+			m.c[9] = T(1) / 2;
+			for(const Entry &entry : extra)
+			{
+				m.a[entry.i][entry.j] = T(entry.value);
+			}
+			for(const Entry &entry : d)
+			{
+				m.dense[entry.j][entry.i] = T(entry.value);
+			}
+			return m;
+		}
+
+		template<typename T>
+		RungeKuttaMethod<T> prince_dormand87_method()
+		{
+			RungeKuttaMethod<T> m = {};
+			m.stages = 13;
+			m.extra = 5;
+			m.order = 8;
+			const T c[19] = {
+				0, T(1) / 18, T(1) / 12, T(1) / 8, T(5) / 16, T(3) / 8, T(59) / 400, T(93) / 200, T(5490023248) / 9719169821, T(13) / 20,
+				T(1201146811) / 1299019798, 1, 1, 1, T(3) / 10, T(7) / 10, T(1) / 5, T(1) / 2, T(17) / 20
+			};
+			/*
+			From Prince & Dormand's RK8(7)13M, to 30 digits, with the eighth order solution's stage at the end.
+			e is the eighth order solution less the seventh order one.
+			The interpolant is seventh order: w[j] = sum d[p][j] theta^(p+1), which matches the step and its slope at theta = 1.
+			It takes five more stages, each accurate to an order less than it, two fifth order ones and then three sixth order ones.
+			*/
+			struct Entry
+			{
+				int i;
+				int j;
+				long double value;
+			};
+			static const Entry a[] = {
+				{1, 0, 5.55555555555555555555555555556e-2L}, {2, 0, 2.08333333333333333333333333333e-2L}, {2, 1, 6.25e-2L},
+				{3, 0, 3.125e-2L}, {3, 2, 9.375e-2L}, {4, 0, 3.125e-1L},
+				{4, 2, -1.171875L}, {4, 3, 1.171875L}, {5, 0, 3.75e-2L},
+				{5, 3, 1.875e-1L}, {5, 4, 1.5e-1L}, {6, 0, 4.79101371111111103879244089548e-2L},
+				{6, 3, 1.12248712777777776975575909878e-1L}, {6, 4, -2.55056737777777777777777777778e-2L}, {6, 5, 1.28468238888888888888888888889e-2L},
+				{7, 0, 1.6917989787292280674952682729e-2L}, {7, 3, 3.87848278486043169559389352298e-1L}, {7, 4, 3.59773698515003281804181954472e-2L},
+				{7, 5, 1.96970214215666059778803651695e-1L}, {7, 6, -1.72713852340501837926401290174e-1L}, {8, 0, 6.90957533591923011118357988839e-2L},
+				{8, 3, -6.34247976728854150797932516219e-1L}, {8, 4, -1.61197575224604079894053091891e-1L}, {8, 5, 1.38650309458825254283192540591e-1L},
+				{8, 6, 9.40928614035756268227813411057e-1L}, {8, 7, 2.11636326481943981406132038347e-1L}, {9, 0, 1.83556996839045385246252414481e-1L},
+				{9, 3, -2.46876808431559244921064724511L}, {9, 4, -2.91286887816300455520575915405e-1L}, {9, 5, -2.64730202331173757661566992079e-2L},
+				{9, 6, 2.84783876419280044328113261675L}, {9, 7, 2.8138733146984979181142983517e-1L}, {9, 8, 1.23744899863314657062618143525e-1L},
+				{10, 0, -1.21542481739588805745534897495L}, {10, 3, 1.667260866594577239908186234e1L}, {10, 4, 9.15741828416817957947323211563e-1L},
+				{10, 5, -6.05660580435747093726112556383L}, {10, 6, -1.60035735941561780837937613172e1L}, {10, 7, 1.48493030862976625183158269105e1L},
+				{10, 8, -1.33715757352898492874183848061e1L}, {10, 9, 5.13418264817963792457857242167L}, {11, 0, 2.58860916438264282030529709249e-1L},
+				{11, 3, -4.7744857854892051023015200188L}, {11, 4, -4.35093013777032508698754069926e-1L}, {11, 5, -3.04948333207224150558441495234L},
+				{11, 6, 5.57792003993609910385994994458L}, {11, 7, 6.15583158986104009363323234254L}, {11, 8, -5.06210458673693836016713669183L},
+				{11, 9, 2.19392617318067905851365981654L}, {11, 10, 1.34627998659334941434280627482e-1L}, {12, 0, 8.22427599626507476048256762859e-1L},
+				{12, 3, -1.16586732572776642646098685907e1L}, {12, 4, -7.57622116690936194364651669307e-1L}, {12, 5, 7.13973588159581526784277545014e-1L},
+				{12, 6, 1.20757749868900567253798261021e1L}, {12, 7, -2.12765911392040265103153459561L}, {12, 8, 1.99016620704895541349598459024L},
+				{12, 9, -2.34286471544040292272732861848e-1L}, {12, 10, 1.75898577707942264813056177202e-1L}, {13, 0, 4.17474911415302460416843130208e-2L},
+				{13, 5, -5.5452328611239309399687295765e-2L}, {13, 6, 2.39312807201180096034416833044e-1L}, {13, 7, 7.03510669403443020486070607946e-1L},
+				{13, 8, -7.59759613814460927827807615666e-1L}, {13, 9, 6.60563030922286339696207260327e-1L}, {13, 10, 1.58187482510123335018691443348e-1L},
+				{13, 11, -2.38109538752862803734890219237e-1L}, {13, 12, 2.5e-1L}
+			};
+			static const Entry e[] = {
+				{0, 0, 1.21942774651767484236838385104e-2L}, {0, 5, 7.7315394787655772878620354752e-1L}, {0, 6, -7.19280928499382309411417014185e-2L},
+				{0, 7, -1.76383452119644395733951252364L}, {0, 8, 1.78718203802744780323467071097L}, {0, 9, -7.82985552754488897417867847408e-1L},
+				{0, 10, 7.87718866289960489768866986795e-2L}, {0, 11, -2.82553983197307248179334663681e-1L}, {0, 12, 2.5e-1L}
+			};
+			static const Entry extra[] = {
+				{14, 0, 4.51719205157850629400439157567e-2L}, {14, 1, 1.17286934157779565316975463404e-17L}, {14, 2, 1.61672631116227821371145742877e-17L},
+				{14, 3, -3.09772101120016646166704438889e-17L}, {14, 4, -1.08863386278935060686063883807e-18L}, {14, 5, 5.7594711995552298633634261349e-2L},
+				{14, 6, 2.16272715903188300440041360663e-1L}, {14, 7, -2.66689001340938943242887395769e-2L}, {14, 8, 1.27908798339588376080388670907e-2L},
+				{14, 9, -5.17417334359801714734674297827e-3L}, {14, 10, -3.72125249047221778254638460457e-4L}, {14, 11, 6.17475319011809100461618944819e-4L},
+				{14, 12, -6.24417286056310819495203801355e-4L}, {14, 13, 3.91912445299139517052748403492e-4L}, {15, 0, 1.35213201222038228817108887732e-2L},
+				{15, 1, 2.46425736426895993897050263817e-17L}, {15, 2, 1.94141796580051220777685079375e-17L}, {15, 3, 2.00095386751963775331091062266e-16L},
+				{15, 4, 2.29816433649560567597605939086e-18L}, {15, 5, -2.20558242114289881615744336791e-1L}, {15, 6, 3.34331351222938487853840425708e-1L},
+				{15, 7, 4.63600519303818905922208293776e-1L}, {15, 8, 8.97473683394370723866792672693e-2L}, {15, 9, 5.28747832487486769480809799452e-3L},
+				{15, 10, 2.36423419722979720442994764638e-3L}, {15, 11, -4.49706290530636543780898124274e-3L}, {15, 12, 3.29182328090540461344145768109e-3L},
+				{15, 13, 5.47849848038362717793117986743e-3L}, {15, 14, 7.43271174780401486819937016389e-3L}, {16, 0, 4.28461782997566758082734943872e-2L},
+				{16, 1, 9.67336946217045897117948364053e-17L}, {16, 2, 3.51739764667619474155444615493e-16L}, {16, 3, -5.51303572698630669728422820229e-16L},
+				{16, 4, -6.96332495916148774524657235226e-17L}, {16, 5, -2.10931316125339634552280712163e-1L}, {16, 6, 2.12609159316647717253834523719e-1L},
+				{16, 7, 5.148333782336697914695673933e-1L}, {16, 8, -4.52507545288683350859315135013e-1L}, {16, 9, 1.60280572488886175348794659278e-1L},
+				{16, 10, -1.27692249681830330372670368971e-2L}, {16, 11, 3.97632399678433138045372024518e-2L}, {16, 12, -2.80860568222776413713025731777e-2L},
+				{16, 13, -7.02470200419623164162921216959e-3L}, {16, 14, -7.05740485737155004184161871521e-2L}, {16, 15, 1.15603654755918906585665843578e-2L},
+				{17, 0, 4.56230128452993267535828935564e-2L}, {17, 1, -2.80633671579458557044457540464e-17L}, {17, 2, 1.07259533482993631991581200877e-16L},
+				{17, 3, -7.12399245275023662135635720428e-17L}, {17, 4, 1.0695030985703797435414456725e-17L}, {17, 5, 1.04646586148353692346801612121e-1L},
+				{17, 6, 2.50177250723526837445956829422e-1L}, {17, 7, 1.02617773120999962599692419654e-2L}, {17, 8, 3.79713479063238263997241076583e-2L},
+				{17, 9, 1.16186662710846068091092982478e-2L}, {17, 10, -2.02922173509109359460516761928e-3L}, {17, 11, 4.73218261592279669797305914309e-3L},
+				{17, 12, -4.93279795896749474478707590679e-3L}, {17, 13, 1.64930562084186675294279996514e-3L}, {17, 14, 1.4425327367461890882797046389e-1L},
+				{17, 15, -1.39404789353728194439692212938e-2L}, {17, 16, -9.00309044886404691619416243986e-2L}, {18, 0, 6.30496654725659401807241650507e-2L},
+				{18, 1, -1.2043400978801047723583813274e-17L}, {18, 2, 7.92770614228240791214134312906e-17L}, {18, 3, 5.17504681820180086146714836752e-16L},
+				{18, 4, -2.84763643056872948281877677496e-18L}, {18, 5, 4.90354229069585179790820974613e-2L}, {18, 6, 7.67391476178717445035198223323e-2L},
+				{18, 7, -1.25382971565138637253809712462e-2L}, {18, 8, 2.50940782513984387158969472518e-2L}, {18, 9, 9.38580436420238157093421632722e-3L},
+				{18, 10, 3.04512325153459853382352583017e-3L}, {18, 11, -5.15899866358760547550362946673e-3L}, {18, 12, 4.22514001042466452512434350419e-3L},
+				{18, 13, 9.2740765399604912862719439442e-3L}, {18, 14, 1.65601657664659147165231908833e-1L}, {18, 15, 2.78759934060953087575494855514e-1L},
+				{18, 16, 1.02048448535216814749079991329e-1L}, {18, 17, 8.14387971443550605249949497004e-2L}
+			};
+			static const Entry d[] = {
+				{0, 0, 1.00059875704786560447500132189L}, {0, 1, -1.96263611976137846268481012985e-16L}, {0, 2, -3.02442899281221423635275906071e-15L},
+				{0, 3, -2.2346299475364015861537529949e-15L}, {0, 4, -6.2833535740486843501260128648e-16L}, {0, 5, 3.79630016372586394112605767043e-2L},
+				{0, 6, -3.53177567562478606592679653953e-3L}, {0, 7, -8.66068821092298850661237843504e-2L}, {0, 8, 8.77532796955364616249877128943e-2L},
+				{0, 9, -3.84457479688411232555095603733e-2L}, {0, 10, 3.86781606596172740692281573191e-3L}, {0, 11, -1.38738182171606477767523553584e-2L},
+				{0, 12, 1.22753695242266912385353487977e-2L}, {0, 13, 4.12481009625604840451815960037e-15L}, {0, 14, -9.73326941741896568133582386923e-15L},
+				{0, 15, -2.16652386031689109743567293506e-15L}, {0, 16, 6.26385548652024905120828684894e-15L}, {0, 17, 2.33490767677782376216093599325e-15L},
+				{0, 18, 1.25779506454085439537087356932e-14L}, {1, 0, -9.53165096037601901099894683885L}, {1, 1, -4.49841923102829904445434983547e-14L},
+				{1, 2, -5.0672143016079514113722141369e-13L}, {1, 3, -7.38570011924309317282423979043e-13L}, {1, 4, -1.68328442160492676510946000208e-14L},
+				{1, 5, 6.0092186101270400156010683999e1L}, {1, 6, 5.09170228894221244037105779147e1L}, {1, 7, -8.52856858483211887927265983428e1L},
+				{1, 8, 1.15386530796186098594991225698e2L}, {1, 9, -5.76585406908875428357863115246e1L}, {1, 10, -9.707179054109367404156738832L},
+				{1, 11, 8.18248086558372508167323927343L}, {1, 12, -1.26810738114859941142972148864e1L}, {1, 13, 6.21027131782985300377297915112L},
+				{1, 14, -2.90169517045290658180012834813e-13L}, {1, 15, -4.58389785066596225699648416024e-14L}, {1, 16, -5.67574786324810649976599687334e1L},
+				{1, 17, -2.52019195275026889364980384001e1L}, {1, 18, 1.6035036554873307969010686926e1L}, {2, 0, 4.19624266052362014298666155304e1L},
+				{2, 1, 3.92963596490151295373952900579e-13L}, {2, 2, 4.59110867168669311159295233518e-12L}, {2, 3, 7.11828787166495739622251543183e-12L},
+				{2, 4, 2.12727358274883527010144229019e-13L}, {2, 5, -4.82166602099581332622584074262e2L}, {2, 6, -3.48412530432627738458077818357e2L},
+				{2, 7, 7.93341807866541385814413690131e2L}, {2, 8, -1.0303157651537040199855877334e3L}, {2, 9, 5.53976864784701836097303605282e2L},
+				{2, 10, 9.51705478523194372369487104556e1L}, {2, 11, -9.0589385216198322698370780285e1L}, {2, 12, 1.27225066253828079772202936913e2L},
+				{2, 13, -5.26860465116317728807171504816e1L}, {2, 14, 3.19111868885967816852925024945e-12L}, {2, 15, 5.62929238009524253163269171902e-13L},
+				{2, 16, 4.22898860398882022984143902551e2L}, {2, 17, 1.29945121200951146525931986496e2L}, {2, 18, -1.60350365548732992350821165199e2L},
+				{3, 0, -9.28340176966769807680838350651e1L}, {3, 1, -1.40962098706897363934147737388e-12L}, {3, 2, -1.70305820305766869175627579478e-11L},
+				{3, 3, -2.77374729322135981306606512835e-11L}, {3, 4, -9.90998742982439842220400230941e-13L}, {3, 5, 1.58317364367573100377794073631e3L},
+				{3, 6, 9.26383384584887620503762870379e2L}, {3, 7, -2.99838169944980103768071226478e3L}, {3, 8, 3.75950660702429246932814254832e3L},
+				{3, 9, -2.14774069533891235725884947601e3L}, {3, 10, -3.74350348612370507944018631623e2L}, {3, 11, 3.86546431218050155225032140826e2L},
+				{3, 12, -5.0873969391394252430009840767e2L}, {3, 13, 1.82785852713193561298010428402e2L}, {3, 14, -1.37685557178062708163959459754e-11L},
+				{3, 15, -2.5881074558943976136365251864e-12L}, {3, 16, -1.1852297008547793735904048309e3L}, {3, 17, -1.72521225544540422164504250694e2L},
+				{3, 18, 6.41401462194931918911733525374e2L}, {4, 0, 1.07826652678007071793461576566e2L}, {4, 1, 2.42045784795362722132491775809e-12L},
+				{4, 2, 2.99254320563598194326349409222e-11L}, {4, 3, 5.03698606445200861211257995627e-11L}, {4, 4, 1.97502377358823439453470240413e-12L},
+				{4, 5, -2.5403566073390318109782123589e3L}, {4, 6, -1.19570171098195912419330181666e3L}, {4, 7, 5.33667565300629751442688986584e3L},
+				{4, 8, -6.53517090058090496246672081184e3L}, {4, 9, 3.88511996876005845245617401203e3L}, {4, 10, 6.83165878288517139615922960256e2L},
+				{4, 11, -7.39013869988979769929746821463e2L}, {4, 12, 9.37612254899183703494706143055e2L}, {4, 13, -3.05060077519407750976815450149e2L},
+				{4, 14, 2.63806269294259017490288416971e-11L}, {4, 15, 5.11477624014197578911135010245e-12L}, {4, 16, 1.5958867521368883915393354264e3L},
+				{4, 17, -4.43912882981613741215948093158e1L}, {4, 18, -1.18659270506062366683749959571e3L}, {5, 0, -6.30540639893443938521069891163e1L},
+				{5, 1, -1.9578089374576239763906603023e-12L}, {5, 2, -2.45717993151577786599232534733e-11L}, {5, 3, -4.22941964194727294909019201758e-11L},
+				{5, 4, -1.74002635947627888307454117894e-12L}, {5, 5, 1.9587818172327417133310051316e3L}, {5, 6, 7.5301465579711772807746353263e2L},
+				{5, 7, -4.41970079390927203465104370675e3L}, {5, 8, 5.33030754974794365865330879265e3L}, {5, 9, -3.24977799148348041222659941027e3L},
+				{5, 10, -5.74342901397478574342022213336e2L}, {5, 11, 6.38250058998716663834340633715e2L}, {5, 12, -7.92823976231567542749558769561e2L},
+				{5, 13, 2.40455426356612619819034134069e2L}, {5, 14, -2.27108141498492792306428002173e-11L}, {5, 15, -4.47475055526720355859124542442e-12L},
+				{5, 16, -1.04389245014256146683901542346e3L}, {5, 17, 2.1257536606365285930704026322e2L}, {5, 18, 1.01020730295701693103398731448e3L},
+				{6, 0, 1.46718020972477850493694483791e1L}, {6, 1, 5.99188883576764020256360302427e-13L}, {6, 2, 7.59558642834888242257313225233e-12L},
+				{6, 3, 1.32843254362950417654363276247e-11L}, {6, 4, 5.60735171386942666105095740472e-13L}, {6, 5, -5.79617852901378471612917335023e2L},
+				{6, 6, -1.85957977273963805451493356862e2L}, {6, 7, 1.37414083588606803378884803213e3L}, {6, 8, -1.64056153472732324151337868237e3L},
+				{6, 9, 1.01677940274741115123101206353e3L}, {6, 10, 1.80218322589566034445578032555e2L}, {6, 11, -2.03599951597708153668182870747e2L},
+				{6, 12, 2.49645147434460051206511139296e2L}, {6, 13, -7.17054263565965143873939435628e1L}, {6, 14, 7.20752705004985474607637644963e-12L},
+				{6, 15, 1.43315839903770226138619800464e-12L}, {6, 16, 2.67094017094051484639722655978e2L}, {6, 17, -1.00406053894399522945136853669e2L},
+				{6, 18, -3.207007310974655113038041166e2L}
+			};
+			for(int i = 0; i < 19; ++i)
+			{
+				m.c[i] = c[i];
+			}
+			for(const Entry &entry : a)
+			{
+				m.a[entry.i][entry.j] = T(entry.value);
+			}
+			for(const Entry &entry : e)
+			{
+				m.e[entry.j] = T(entry.value);
+			}
+			for(const Entry &entry : extra)
+			{
+				m.a[entry.i][entry.j] = T(entry.value);
+			}
+			for(const Entry &entry : d)
+			{
+				m.dense[entry.j][entry.i] = T(entry.value);
+			}
+			return m;
+		}
+
+		template<typename T>
+		RungeKuttaMethod<T> dop853_method()
+		{
+			RungeKuttaMethod<T> m = {};
+			m.stages = 12;
+			m.extra = 3;
+			m.order = 8;
+			m.tempered = true;
+			//From Hairer's DOP853, to 30 digits.
+			struct Entry
+			{
+				int i;
+				int j;
+				long double value;
+			};
+			static const long double c[16] = {
+				0.0L, 0.526001519587677318785587544488e-01L, 0.789002279381515978178381316732e-01L, 0.118350341907227396726757197510L,
+				0.281649658092772603273242802490L, 0.333333333333333333333333333333L, 0.25L, 0.307692307692307692307692307692L,
+				0.651282051282051282051282051282L, 0.6L, 0.857142857142857142857142857142L, 1.0L,
+				1.0L, 0.1L, 0.2L, 0.777777777777777777777777777778L
+			};
+			static const Entry a[] = {
+				{1, 0, 5.26001519587677318785587544488e-2L}, {2, 0, 1.97250569845378994544595329183e-2L}, {2, 1, 5.91751709536136983633785987549e-2L},
+				{3, 0, 2.95875854768068491816892993775e-2L}, {3, 2, 8.87627564304205475450678981324e-2L}, {4, 0, 2.41365134159266685502369798665e-1L},
+				{4, 2, -8.84549479328286085344864962717e-1L}, {4, 3, 9.24834003261792003115737966543e-1L}, {5, 0, 3.7037037037037037037037037037e-2L},
+				{5, 3, 1.70828608729473871279604482173e-1L}, {5, 4, 1.25467687566822425016691814123e-1L}, {6, 0, 3.7109375e-2L},
+				{6, 3, 1.70252211019544039314978060272e-1L}, {6, 4, 6.02165389804559606850219397283e-2L}, {6, 5, -1.7578125e-2L},
+				{7, 0, 3.70920001185047927108779319836e-2L}, {7, 3, 1.70383925712239993810214054705e-1L}, {7, 4, 1.07262030446373284651809199168e-1L},
+				{7, 5, -1.53194377486244017527936158236e-2L}, {7, 6, 8.27378916381402288758473766002e-3L}, {8, 0, 6.24110958716075717114429577812e-1L},
+				{8, 3, -3.36089262944694129406857109825L}, {8, 4, -8.68219346841726006818189891453e-1L}, {8, 5, 2.75920996994467083049415600797e1L},
+				{8, 6, 2.01540675504778934086186788979e1L}, {8, 7, -4.34898841810699588477366255144e1L}, {9, 0, 4.77662536438264365890433908527e-1L},
+				{9, 3, -2.48811461997166764192642586468L}, {9, 4, -5.90290826836842996371446475743e-1L}, {9, 5, 2.12300514481811942347288949897e1L},
+				{9, 6, 1.52792336328824235832596922938e1L}, {9, 7, -3.32882109689848629194453265587e1L}, {9, 8, -2.03312017085086261358222928593e-2L},
+				{10, 0, -9.3714243008598732571704021658e-1L}, {10, 3, 5.18637242884406370830023853209L}, {10, 4, 1.09143734899672957818500254654L},
+				{10, 5, -8.14978701074692612513997267357L}, {10, 6, -1.85200656599969598641566180701e1L}, {10, 7, 2.27394870993505042818970056734e1L},
+				{10, 8, 2.49360555267965238987089396762L}, {10, 9, -3.0467644718982195003823669022L}, {11, 0, 2.27331014751653820792359768449L},
+				{11, 3, -1.05344954667372501984066689879e1L}, {11, 4, -2.00087205822486249909675718444L}, {11, 5, -1.79589318631187989172765950534e1L},
+				{11, 6, 2.79488845294199600508499808837e1L}, {11, 7, -2.85899827713502369474065508674L}, {11, 8, -8.87285693353062954433549289258L},
+				{11, 9, 1.23605671757943030647266201528e1L}, {11, 10, 6.43392746015763530355970484046e-1L}, {12, 0, 5.42937341165687622380535766363e-2L},
+				{12, 5, 4.45031289275240888144113950566L}, {12, 6, 1.89151789931450038304281599044L}, {12, 7, -5.8012039600105847814672114227L},
+				{12, 8, 3.1116436695781989440891606237e-1L}, {12, 9, -1.52160949662516078556178806805e-1L}, {12, 10, 2.01365400804030348374776537501e-1L},
+				{12, 11, 4.47106157277725905176885569043e-2L}, {13, 0, 5.61675022830479523392909219681e-2L}, {13, 6, 2.53500210216624811088794765333e-1L},
+				{13, 7, -2.46239037470802489917441475441e-1L}, {13, 8, -1.24191423263816360469010140626e-1L}, {13, 9, 1.5329179827876569731206322685e-1L},
+				{13, 10, 8.20105229563468988491666602057e-3L}, {13, 11, 7.56789766054569976138603589584e-3L}, {13, 12, -8.298e-3L},
+				{14, 0, 3.18346481635021405060768473261e-2L}, {14, 5, 2.83009096723667755288322961402e-2L}, {14, 6, 5.35419883074385676223797384372e-2L},
+				{14, 7, -5.49237485713909884646569340306e-2L}, {14, 10, -1.08347328697249322858509316994e-4L}, {14, 11, 3.82571090835658412954920192323e-4L},
+				{14, 12, -3.40465008687404560802977114492e-4L}, {14, 13, 1.41312443674632500278074618366e-1L}, {15, 0, -4.28896301583791923408573538692e-1L},
+				{15, 5, -4.69762141536116384314449447206L}, {15, 6, 7.68342119606259904184240953878L}, {15, 7, 4.06898981839711007970213554331L},
+				{15, 8, 3.56727187455281109270669543021e-1L}, {15, 12, -1.39902416515901462129418009734e-3L}, {15, 13, 2.9475147891527723389556272149L},
+				{15, 14, -9.15095847217987001081870187138L}
+			};
+			static const Entry e5[] = {
+				{0, 0, 0.1312004499419488073250102996e-1L}, {0, 5, -0.1225156446376204440720569753e+1L}, {0, 6, -0.4957589496572501915214079952L},
+				{0, 7, 0.1664377182454986536961530415e+1L}, {0, 8, -0.3503288487499736816886487290L}, {0, 9, 0.3341791187130174790297318841L},
+				{0, 10, 0.8192320648511571246570742613e-1L}, {0, 11, -0.2235530786388629525884427845e-1L}
+			};
+			//The third order solution's weights, which e3 is the difference from.
+			static const Entry b3[] = {
+				{0, 0, 0.244094488188976377952755905512L}, {0, 8, 0.733846688281611857341361741547L}, {0, 11, 0.220588235294117647058823529412e-1L}
+			};
+			//The interpolant's higher coefficients, which take the extra stages.
+			static const Entry d[] = {
+				{0, 0, -0.84289382761090128651353491142e+1L}, {0, 5, 0.56671495351937776962531783590L}, {0, 6, -0.30689499459498916912797304727e+1L},
+				{0, 7, 0.23846676565120698287728149680e+1L}, {0, 8, 0.21170345824450282767155149946e+1L}, {0, 9, -0.87139158377797299206789907490L},
+				{0, 10, 0.22404374302607882758541771650e+1L}, {0, 11, 0.63157877876946881815570249290L}, {0, 12, -0.88990336451333310820698117400e-1L},
+				{0, 13, 0.18148505520854727256656404962e+2L}, {0, 14, -0.91946323924783554000451984436e+1L}, {0, 15, -0.44360363875948939664310572000e+1L},
+				{1, 0, 0.10427508642579134603413151009e+2L}, {1, 5, 0.24228349177525818288430175319e+3L}, {1, 6, 0.16520045171727028198505394887e+3L},
+				{1, 7, -0.37454675472269020279518312152e+3L}, {1, 8, -0.22113666853125306036270938578e+2L}, {1, 9, 0.77334326684722638389603898808e+1L},
+				{1, 10, -0.30674084731089398182061213626e+2L}, {1, 11, -0.93321305264302278729567221706e+1L}, {1, 12, 0.15697238121770843886131091075e+2L},
+				{1, 13, -0.31139403219565177677282850411e+2L}, {1, 14, -0.93529243588444783865713862664e+1L}, {1, 15, 0.35816841486394083752465898540e+2L},
+				{2, 0, 0.19985053242002433820987653617e+2L}, {2, 5, -0.38703730874935176555105901742e+3L}, {2, 6, -0.18917813819516756882830838328e+3L},
+				{2, 7, 0.52780815920542364900561016686e+3L}, {2, 8, -0.11573902539959630126141871134e+2L}, {2, 9, 0.68812326946963000169666922661e+1L},
+				{2, 10, -0.10006050966910838403183860980e+1L}, {2, 11, 0.77771377980534432092869265740L}, {2, 12, -0.27782057523535084065932004339e+1L},
+				{2, 13, -0.60196695231264120758267380846e+2L}, {2, 14, 0.84320405506677161018159903784e+2L}, {2, 15, 0.11992291136182789328035130030e+2L},
+				{3, 0, -0.25693933462703749003312586129e+2L}, {3, 5, -0.15418974869023643374053993627e+3L}, {3, 6, -0.23152937917604549567536039109e+3L},
+				{3, 7, 0.35763911791061412378285349910e+3L}, {3, 8, 0.93405324183624310003907691704e+2L}, {3, 9, -0.37458323136451633156875139351e+2L},
+				{3, 10, 0.10409964950896230045147246184e+3L}, {3, 11, 0.29840293426660503123344363579e+2L}, {3, 12, -0.43533456590011143754432175058e+2L},
+				{3, 13, 0.96324553959188282948394950600e+2L}, {3, 14, -0.39177261675615439165231486172e+2L}, {3, 15, -0.14972683625798562581422125276e+3L}
+			};
+			for(int i = 0; i < 16; ++i)
+			{
+				m.c[i] = T(c[i]);
+			}
+			for(const Entry &entry : a)
+			{
+				m.a[entry.i][entry.j] = T(entry.value);
+			}
+			for(const Entry &entry : e5)
+			{
+				m.e[entry.j] = T(entry.value);
+			}
+			for(int j = 0; j < 12; ++j)
+			{
+				m.e3[j] = m.a[12][j];
+			}
+			for(const Entry &entry : b3)
+			{
+				m.e3[entry.j] -= T(entry.value);
+			}
+			T rows[4][16] = {};
+			for(const Entry &entry : d)
+			{
+				rows[entry.i][entry.j] = T(entry.value);
+			}
+
+			/*
+			The interpolant is y + theta (F0 + (1-theta) (F1 + theta (F2 + (1-theta) (F3 + theta (F4 + (1-theta) (F5 + theta F6)))))),
+			with F0 = y1 - y, F1 = h k[0] - F0, F2 = 2 F0 - h (k[0] + k[12]) and F3..F6 = h sum d[.][j] k[j].
+			Multiply that out into powers of theta, stage by stage.
+			*/
+			for(int j = 0; j < 16; ++j)
+			{
+				const T b = j < 12 ? m.a[12][j] : 0;
+				const T f[7] = {b, T(j == 0) - b, 2 * b - (j == 0) - (j == 12), rows[0][j], rows[1][j], rows[2][j], rows[3][j]};
+				//Horner from the inside out, in coefficients of theta^0..theta^6: F5 + theta F6, then F4 + (1-theta) (...), and so on.
+				T poly[8] = {f[6]};
+				for(int level = 5; level >= 0; --level)
+				{
+					const bool byTheta = level % 2 == 1;
+					T next[8] = {};
+					for(int p = 0; p < 7; ++p)
+					{
+						if(!byTheta)
+						{
+							next[p] += poly[p];
+						}
+						next[p + 1] += (byTheta ? 1 : -1) * poly[p];
+					}
+					next[0] += f[level];
+					std::copy(next, next + 8, poly);
+				}
+				//And the theta in front.
+				for(int p = 0; p < 7; ++p)
+				{
+					m.dense[j][p] = poly[p];
+				}
+			}
+			return m;
+		}
+
+		/**
+		 * @brief The coefficients of a method, in the scalar type of the solution.
+		 * 
+		 */
+		template<typename T>
+		const RungeKuttaMethod<T> &runge_kutta_method(RungeKutta method)
+		{
+			static const RungeKuttaMethod<T> rk4 = rk4_method<T>();
+			static const RungeKuttaMethod<T> dormandPrince = dormand_prince_method<T>();
+			static const RungeKuttaMethod<T> verner65 = verner65_method<T>();
+			static const RungeKuttaMethod<T> princeDormand87 = prince_dormand87_method<T>();
+			static const RungeKuttaMethod<T> dop853 = dop853_method<T>();
+			switch(method)
+			{
+			case RungeKutta::RK4:
+				return rk4;
+			case RungeKutta::Verner65:
+				return verner65;
+			case RungeKutta::PrinceDormand87:
+				return princeDormand87;
+			case RungeKutta::DOP853:
+				return dop853;
+			default:
+				return dormandPrince;
+			}
+		}
+	}
+
+	/**
+	 * @brief The scalar type of an ODE's state: the state itself, or its elements for std::array and std::vector.
+	 * 
+	 */
+	template<typename State>
+	using OdeScalar = typename detail::OdeState<State>::scalar;
+
+	/**
+	 * @brief The right side of y' = f(t, y), returning the derivative of the state.
+	 * 
+	 */
+	template<typename State>
+	using OdeFunc = std::function<State(OdeScalar<State>, const State&)>;
+
+	/**
+	 * @brief The right sides of many independent ODEs at once, for ode_solve_batch().
+	 * 
+	 * @remarks Takes each solution's t, and all their states component by component: every solution's first component,
+	 * 		then every solution's second, and so on, so a loop over the solutions runs over consecutive values and vectorizes.
+	 * 		Writes the derivatives, already sized, in the same layout.
+	 * 
+	 */
+	template<typename T>
+	using BasicBatchOdeFunc = std::function<void(const std::vector<T> &t, const std::vector<T> &y, std::vector<T> &dydt)>;
+
+	typedef BasicBatchOdeFunc<double> BatchOdeFunc;
+
+	namespace detail
+	{
+		/**
+		 * @brief A component's scale in the error norm: max(abs_tol, rel_tol |y|), with y the larger of its values either side of the step.
+		 * 
+		 */
+		template<typename T>
+		T ode_scale(T y, T other, const BasicOptions<T> &opts)
+		{
+			return std::max(opts.abs_tol, opts.rel_tol * std::max(detail::abs(y), detail::abs(other)));
+		}
+
+		/**
+		 * @brief A component relative to its scale, where 0 is always 0, even at a scale of 0.
+		 * 
+		 */
+		template<typename T>
+		T ode_relative(T value, T scale)
+		{
+			return value == 0 ? T(0) : value / scale;
+		}
+
+		/**
+		 * @brief The RMS of a step's scaled error from the sums of squares of the scaled components of both its estimates.
+		 * 
+		 * @remarks Tempered (DOP853) divides the main estimate by the lower order one, as Hairer's DOP853 does,
+		 * 		so the norm comes out as if the method were of the main estimate's order.
+		 * 
+		 */
+		template<typename T>
+		T ode_error_norm(T h, T sum5, T sum3, std::size_t n, bool tempered)
+		{
+			if(!tempered)
+			{
+				return detail::abs(h) * detail::sqrt(sum5 / T(n));
+			}
+			return sum5 == 0 ? T(0) : detail::abs(h) * sum5 / detail::sqrt((sum5 + T(0.01) * sum3) * T(n));
+		}
+
+		/**
+		 * @brief The error estimate of one component of a step that's taken, tempered the same way as the norm.
+		 * 
+		 */
+		template<typename T>
+		T ode_local_error(T h, T e5, T e3, bool tempered)
+		{
+			T error = detail::abs(h * e5);
+			if(tempered && e5 != 0)
+			{
+				error *= detail::abs(e5) / detail::sqrt(e5 * e5 + T(0.01) * e3 * e3);
+			}
+			return error;
+		}
+
+		/**
+		 * @brief Hairer's controller: the step to take after one of size h whose error norm came out as norm.
+		 * 
+		 * @param rejected Whether a step was rejected since the last one taken.
+		 * 
+		 * @remarks A rejected step (norm over 1, or NAN where the stages weren't finite) shrinks at most five-fold.
+		 * 		A step that's taken grows at most ten-fold, and not at all right after a rejection.
+		 * 
+		 */
+		template<typename T>
+		T ode_next_step(T h, T norm, int order, bool rejected)
+		{
+			if(!(norm <= 1))
+			{
+				return h * (detail::isfinite(norm) ? std::max(T(0.2), T(0.9) * detail::pow(norm, T(-1) / order)) : T(0.2));
+			}
+			T factor = norm == 0 ? T(10) : std::min(T(10), T(0.9) * detail::pow(norm, T(-1) / order));
+			if(rejected)
+			{
+				factor = std::min(T(1), factor);
+			}
+			return h * factor;
+		}
+
+		/**
+		 * @brief The first half of Hairer's initial step: a trial Euler step that changes y by 1% of its scale.
+		 * 
+		 * @param d0 The RMS of y relative to its scale, as ode_initial_scale() has it.
+		 * @param d1 The RMS of f(t, y) relative to the same scale.
+		 * 
+		 */
+		template<typename T>
+		T ode_trial_step(T d0, T d1, T left)
+		{
+			return std::min((d0 < T(1e-5) || d1 < T(1e-5)) ? T(1e-6) : T(0.01) * d0 / d1, left);
+		}
+
+		/**
+		 * @brief The second half of Hairer's initial step: small enough that f changes by less than 1% of the scale over it too.
+		 * 
+		 * @param h0 The trial step.
+		 * @param d1 The RMS of f(t, y) relative to the scale.
+		 * @param d2 The RMS of the change of f over the trial step relative to the scale, divided by h0.
+		 * @param order How fast the error estimate of the method shrinks with the step.
+		 * 
+		 */
+		template<typename T>
+		T ode_guessed_step(T h0, T d1, T d2, int order, T left)
+		{
+			const T h1 = (d1 <= T(1e-15) && d2 <= T(1e-15)) ? std::max(T(1e-6), h0 * T(1e-3))
+							: detail::pow(T(0.01) / std::max(d1, d2), T(1) / order);
+			return std::min(std::min(100 * h0, h1), left);
+		}
+
+		/**
+		 * @brief The scale of a component of y for the initial step. Components that start at 0, with no absolute tolerance,
+		 * 		are scaled as if they started at 1.
+		 * 
+		 */
+		template<typename T>
+		T ode_initial_scale(T y, const BasicOptions<T> &opts)
+		{
+			const T scale = ode_scale(y, T(0), opts);
+			return scale > 0 ? scale : opts.rel_tol;
+		}
+
+		/**
+		 * @brief Hairer's guess at the first step: small enough that an Euler step changes y by 1% of its scale, and f by less.
+		 * 
+		 * @param f0 f(t, y).
+		 * @param temp Room for the one evaluation it takes, sized like y.
+		 * @param order How fast the error estimate of the method shrinks with the step.
+		 * 
+		 */
+		template<typename State, typename T = typename OdeState<State>::scalar>
+		T ode_initial_step(const OdeFunc<State> &f, T t, const State &y, const State &f0, State &temp, T direction, T left, int order,
+						   const BasicOptions<T> &opts)
+		{
+			typedef OdeState<State> Traits;
+			const std::size_t n = Traits::size(y);
+			T d0 = 0;
+			T d1 = 0;
+			for(std::size_t i = 0; i < n; ++i)
+			{
+				const T scale = ode_initial_scale(Traits::at(y, i), opts);
+				d0 += detail::pow(ode_relative(Traits::at(y, i), scale), 2);
+				d1 += detail::pow(ode_relative(Traits::at(f0, i), scale), 2);
+			}
+			d0 = detail::sqrt(d0 / T(n));
+			d1 = detail::sqrt(d1 / T(n));
+			const T h0 = ode_trial_step(d0, d1, left);
+
+			for(std::size_t i = 0; i < n; ++i)
+			{
+				Traits::at(temp, i) = Traits::at(y, i) + direction * h0 * Traits::at(f0, i);
+			}
+			const State f1 = f(t + direction * h0, temp);
+			T d2 = 0;
+			for(std::size_t i = 0; i < n; ++i)
+			{
+				d2 += detail::pow(ode_relative(Traits::at(f1, i) - Traits::at(f0, i), ode_initial_scale(Traits::at(y, i), opts)), 2);
+			}
+			d2 = detail::sqrt(d2 / T(n)) / h0;
+			return ode_guessed_step(h0, d1, d2, order, left);
+		}
+	}
+
+	/**
+	 * @brief Steps the solution of y' = f(t, y) along, one explicit Runge-Kutta step at a time, with interpolation in between.
+	 * 
+	 * @remarks The state can be a scalar, a std::array, or a std::vector (which all have to be the same size).
+	 * 		Stepping doesn't allocate, so with scalars and std::array nothing does, beyond whatever f itself does.
+	 * 		Steps are sized so each one's estimated error, scaled component by component by max(abs_tol, rel_tol |y|),
+	 * 		has an RMS of at most 1, with Hairer's controller and initial step.
+	 * 
+	 */
+	template<typename State>
+	class OdeStepper
+	{
+	public:
+		typedef OdeScalar<State> T;
+
+		/**
+		 * @brief Starts a solution.
+		 * 
+		 * @param f The right side.
+		 * @param t0 Where the solution starts.
+		 * @param y0 The solution there.
+		 * @param opts The method, tolerances, evaluation budget, and the fixed step of RungeKutta::RK4.
+		 */
+		OdeStepper(OdeFunc<State> f, T t0, const State &y0, const BasicOptions<T> &opts = BasicOptions<T>())
+			: mF(f), mMethod(&detail::runge_kutta_method<T>(opts.ode)), mOpts(opts), mT(t0), mTOld(t0), mH(0),
+			  mY(y0), mYOld(y0), mTemp(y0), mError(y0), mEvaluations(0), mSteps(0), mRejected(0), mInterpolated(false)
+		{
+			mK.fill(y0);
+			for(std::size_t i = 0; i < Traits::size(mError); ++i)
+			{
+				Traits::at(mError, i) = 0;
+			}
+			mK[0] = mF(mT, mY);
+			mEvaluations = 1;
+		}
+
+		/**
+		 * @brief Takes one step towards a point, retrying it smaller until it's accurate enough.
+		 * 
+		 * @param end Where the solution is headed. The step is cut short to land on it.
+		 * @return bool Whether a step was taken. False once the solution is at end, or when it can't go on:
+		 * 		the budget of max_evaluations ran out, or the step shrank to nothing, as it does at a singularity or once f isn't finite.
+		 */
+		bool step(T end)
+		{
+			if(mT == end)
+			{
+				return false;
+			}
+			const int stages = mMethod->stages;
+			const T direction = end > mT ? 1 : -1;
+			const T left = detail::abs(end - mT);
+			const T smallest = 10 * detail::epsilon<T>() * std::max(detail::abs(mT), std::numeric_limits<T>::min());
+			if(mSteps > 0)
+			{
+				//The last stage of the step before is the first of this one.
+				std::swap(mK[0], mK[stages]);
+			}
+			if(mH == 0)
+			{
+				if(mMethod->order == 0)
+				{
+					mH = mOpts.step;
+				}
+				else
+				{
+					mH = detail::ode_initial_step(mF, mT, mY, mK[0], mTemp, direction, left, mMethod->order, mOpts);
+					++mEvaluations;
+				}
+			}
+
+			bool rejected = false;
+			while(mEvaluations + stages <= mOpts.max_evaluations && mH > smallest)
+			{
+				const bool last = mH >= left;
+				const T h = direction * (last ? left : mH);
+				for(int s = 1; s <= stages; ++s)
+				{
+					mStage(s, h, mT, mY);
+				}
+				mEvaluations += stages;
+
+				const T norm = mErrorNorm(h);
+				if(!(norm <= 1))
+				{
+					//Including NAN, where the stages weren't finite.
+					mH = detail::ode_next_step(detail::abs(h), norm, mMethod->order, true);
+					rejected = true;
+					++mRejected;
+					continue;
+				}
+				mAccumulateError(h);
+				mTOld = mT;
+				mT = last ? end : mT + h;
+				std::swap(mYOld, mY);
+				std::swap(mY, mTemp);
+				mInterpolated = false;
+				++mSteps;
+				if(mMethod->order > 0)
+				{
+					mH = detail::ode_next_step(detail::abs(h), norm, mMethod->order, rejected);
+				}
+				return true;
+			}
+			//Back where the next call expects it.
+			if(mSteps > 0)
+			{
+				std::swap(mK[0], mK[stages]);
+			}
+			return false;
+		}
+
+		/**
+		 * @brief The solution in the last step, between t of the step before and t(). Only good if the last call to step() took a step.
+		 * 
+		 * @param t Where to interpolate. Outside the last step, the interpolant is extrapolated, which quickly goes wrong.
+		 * @param out Where the solution goes, already sized like the state.
+		 * 
+		 * @remarks Verner65, PrinceDormand87 and DOP853 take their extra evaluations the first time each step is interpolated.
+		 * 
+		 */
+		void interpolate(T t, State &out)
+		{
+			if(mT == mTOld)
+			{
+				out = mY;
+				return;
+			}
+			const T h = mT - mTOld;
+			if(mMethod->extra > 0 && !mInterpolated)
+			{
+				for(int s = mMethod->stages + 1; s <= mMethod->stages + mMethod->extra; ++s)
+				{
+					mStage(s, h, mTOld, mYOld);
+				}
+				mEvaluations += mMethod->extra;
+				mInterpolated = true;
+			}
+			const T theta = (t - mTOld) / h;
+			const int count = mMethod->stages + 1 + mMethod->extra;
+			T weights[detail::RungeKuttaMethod<T>::MAX_STAGES] = {};
+			for(int j = 0; j < count; ++j)
+			{
+				for(int p = detail::RungeKuttaMethod<T>::MAX_DEGREE - 1; p >= 0; --p)
+				{
+					weights[j] = (weights[j] + mMethod->dense[j][p]) * theta;
+				}
+			}
+			for(std::size_t i = 0; i < Traits::size(mY); ++i)
+			{
+				T sum = 0;
+				for(int j = 0; j < count; ++j)
+				{
+					sum += weights[j] * Traits::at(mK[j], i);
+				}
+				Traits::at(out, i) = Traits::at(mYOld, i) + h * sum;
+			}
+		}
+
+		/**
+		 * @brief Where the solution is.
+		 * 
+		 */
+		T t() const
+		{
+			return mT;
+		}
+
+		/**
+		 * @brief The solution at t().
+		 * 
+		 */
+		const State &y() const
+		{
+			return mY;
+		}
+
+		/**
+		 * @brief The sum of the error estimates of the steps so far, component by component. 0 for RungeKutta::RK4.
+		 * 
+		 * @remarks That's the error made along the way, not how far off the solution is: errors can grow or shrink as the solution goes on.
+		 * 
+		 */
+		const State &error() const
+		{
+			return mError;
+		}
+
+		/**
+		 * @brief How many times f was evaluated.
+		 * 
+		 */
+		std::size_t evaluations() const
+		{
+			return mEvaluations;
+		}
+
+		/**
+		 * @brief How many steps were taken, not counting rejected ones.
+		 * 
+		 */
+		std::size_t steps() const
+		{
+			return mSteps;
+		}
+
+		/**
+		 * @brief How many steps were rejected as not accurate enough and retried smaller.
+		 * 
+		 */
+		std::size_t rejected() const
+		{
+			return mRejected;
+		}
+	private:
+		typedef detail::OdeState<State> Traits;
+
+		OdeFunc<State> mF;
+		const detail::RungeKuttaMethod<T> *mMethod;
+		BasicOptions<T> mOpts;
+		T mT;
+		T mTOld;
+		//The next step to try, without its sign. 0 until the first step.
+		T mH;
+		State mY;
+		State mYOld;
+		//The stages in between, and the new solution after a step.
+		State mTemp;
+		State mError;
+		std::array<State, detail::RungeKuttaMethod<T>::MAX_STAGES> mK;
+		std::size_t mEvaluations;
+		std::size_t mSteps;
+		std::size_t mRejected;
+		//Whether the extra stages of the last step were evaluated.
+		bool mInterpolated;
+
+		//Evaluates stage s of a step from (t, y) into mK[s], leaving its argument in mTemp.
+		void mStage(int s, T h, T t, const State &y)
+		{
+			for(std::size_t i = 0; i < Traits::size(y); ++i)
+			{
+				T sum = 0;
+				for(int j = 0; j < s; ++j)
+				{
+					if(mMethod->a[s][j] != 0)
+					{
+						sum += mMethod->a[s][j] * Traits::at(mK[j], i);
+					}
+				}
+				Traits::at(mTemp, i) = Traits::at(y, i) + h * sum;
+			}
+			mK[s] = mF(t + mMethod->c[s] * h, mTemp);
+		}
+
+		//How much a component is allowed to be off by.
+		T mScale(std::size_t i) const
+		{
+			return detail::ode_scale(Traits::at(mY, i), Traits::at(mTemp, i), mOpts);
+		}
+
+		//The RMS of the scaled error of the step just tried; for DOP853, the fifth order estimate tempered by the third order one.
+		T mErrorNorm(T h) const
+		{
+			if(mMethod->order == 0)
+			{
+				return 0;
+			}
+			const std::size_t n = Traits::size(mY);
+			const int count = mMethod->stages + 1;
+			T sum5 = 0;
+			T sum3 = 0;
+			for(std::size_t i = 0; i < n; ++i)
+			{
+				T e5 = 0;
+				T e3 = 0;
+				for(int j = 0; j < count; ++j)
+				{
+					e5 += mMethod->e[j] * Traits::at(mK[j], i);
+					e3 += mMethod->e3[j] * Traits::at(mK[j], i);
+				}
+				const T scale = mScale(i);
+				sum5 += detail::pow(detail::ode_relative(e5, scale), 2);
+				sum3 += detail::pow(detail::ode_relative(e3, scale), 2);
+			}
+			return detail::ode_error_norm(h, sum5, sum3, n, mMethod->tempered);
+		}
+
+		//Adds the error estimate of the step just taken, component by component.
+		void mAccumulateError(T h)
+		{
+			if(mMethod->order == 0)
+			{
+				return;
+			}
+			const int count = mMethod->stages + 1;
+			for(std::size_t i = 0; i < Traits::size(mY); ++i)
+			{
+				T e5 = 0;
+				T e3 = 0;
+				for(int j = 0; j < count; ++j)
+				{
+					e5 += mMethod->e[j] * Traits::at(mK[j], i);
+					e3 += mMethod->e3[j] * Traits::at(mK[j], i);
+				}
+				Traits::at(mError, i) += detail::ode_local_error(h, e5, e3, mMethod->tempered);
+			}
+		}
+	};
+
+	namespace detail
+	{
+		/**
+		 * @brief Steps the solution to t1, and reports where it got as ode_solve() and stiff_solve() do.
+		 * 
+		 */
+		template<typename State, typename Stepper>
+		BasicEstimate<State> solve_to(Stepper &stepper, OdeScalar<State> t1)
+		{
+			while(stepper.step(t1))
+			{
+			}
+			BasicEstimate<State> est = {stepper.y(), stepper.error(), stepper.evaluations()};
+			if(stepper.t() != t1)
+			{
+				for(std::size_t i = 0; i < OdeState<State>::size(est.error); ++i)
+				{
+					OdeState<State>::at(est.error, i) = infinity<OdeScalar<State>>();
+				}
+			}
+			return est;
+		}
+
+		/**
+		 * @brief Steps the solution through a list of times, interpolating at each, as ode_solve_at() and stiff_solve_at() do.
+		 * 
+		 */
+		template<typename State, typename Stepper>
+		std::vector<State> solve_at(Stepper &stepper, OdeScalar<State> t0, const State &y0, const std::vector<OdeScalar<State>> &times)
+		{
+			typedef OdeScalar<State> T;
+			std::vector<State> out(times.size(), y0);
+			const T end = times.back();
+			const T direction = end < t0 ? -1 : 1;
+			for(std::size_t k = 0; k < times.size(); ++k)
+			{
+				while((times[k] - stepper.t()) * direction > 0 && stepper.step(end))
+				{
+				}
+				if((times[k] - stepper.t()) * direction > 0)
+				{
+					for(std::size_t i = 0; i < OdeState<State>::size(out[k]); ++i)
+					{
+						OdeState<State>::at(out[k], i) = NAN;
+					}
+					continue;
+				}
+				stepper.interpolate(times[k], out[k]);
+			}
+			return out;
+		}
+	}
+
+	/**
+	 * @brief Solves y' = f(t, y) from t0 to t1.
+	 * 
+	 * @param f The right side. The state can be a scalar, a std::array or a std::vector.
+	 * @param t0 Where the solution starts.
+	 * @param y0 The solution there.
+	 * @param t1 Where to solve to. It may be before t0.
+	 * @param opts The method (see RungeKutta), tolerances, evaluation budget, and the fixed step of RungeKutta::RK4.
+	 * @return BasicEstimate<State> The solution at t1, with the sum of its steps' error estimates, component by component.
+	 * 		If it couldn't get there (see OdeStepper::step()), it's the solution where it stopped, with infinite errors.
+	 * 
+	 * @see OdeStepper
+	 * 
+	 */
+	template<typename State>
+	BasicEstimate<State> ode_solve(NoDeduce<OdeFunc<State>> f, OdeScalar<State> t0, const State &y0, OdeScalar<State> t1,
+								   const BasicOptions<OdeScalar<State>> &opts = BasicOptions<OdeScalar<State>>())
+	{
+		OdeStepper<State> stepper(f, t0, y0, opts);
+		return detail::solve_to<State>(stepper, t1);
+	}
+
+	/**
+	 * @brief Solves y' = f(t, y) from t0, and interpolates the solution at a list of times.
+	 * 
+	 * @param f The right side. The state can be a scalar, a std::array or a std::vector.
+	 * @param t0 Where the solution starts.
+	 * @param y0 The solution there.
+	 * @param times Where to interpolate, in order away from t0 (either way).
+	 * @param opts The method (see RungeKutta), tolerances, evaluation budget, and the fixed step of RungeKutta::RK4.
+	 * @return std::vector<State> The solution at each time, NAN past wherever the solver had to stop.
+	 * 
+	 * @remarks The steps are sized for accuracy alone, however close together the times are, and the solution in between
+	 * 		comes from each method's interpolant, which is about as accurate as the steps.
+	 * 
+	 */
+	template<typename State>
+	std::vector<State> ode_solve_at(NoDeduce<OdeFunc<State>> f, OdeScalar<State> t0, const State &y0,
+									const std::vector<OdeScalar<State>> &times,
+									const BasicOptions<OdeScalar<State>> &opts = BasicOptions<OdeScalar<State>>())
+	{
+		if(times.empty())
+		{
+			return std::vector<State>();
+		}
+		OdeStepper<State> stepper(f, t0, y0, opts);
+		return detail::solve_at<State>(stepper, t0, y0, times);
+	}
+
+	/**
+	 * @brief Solves many independent ODEs of the same size from t0 to t1 at once, with a batched right side.
+	 * 
+	 * @param f The right sides, which take the solutions component by component (see BasicBatchOdeFunc).
+	 * 		With opts.threads other than 1, blocks of solutions are solved on several threads at once, so f must be thread-safe.
+	 * @param t0 Where the solutions start.
+	 * @param y0 The solutions there, component by component: the first component of each, then the second, and so on.
+	 * @param count How many solutions there are.
+	 * @param t1 Where to solve to.
+	 * @param opts The method, tolerances, threads, the fixed step of RungeKutta::RK4, and max_evaluations for each solution.
+	 * @return BasicEstimate<std::vector<T>> The solutions at t1 and their error estimates, laid out like y0,
+	 * 		with infinite errors for any solution that couldn't get there. The evaluations count every solution in every call to f.
+	 * 
+	 * @remarks Solutions are taken 64 at a time, each with its own steps, but all stepping together, so every stage is one call to f,
+	 * 		and every loop in between runs over the solutions with nothing in the way of vectorizing it. Solutions that are done
+	 * 		sit out the rest of their block with empty steps, so blocks of similar solutions waste the least.
+	 * 		It's the same method, and the same detail:: initial step & controller as OdeStepper, so each solution comes out
+	 * 		as it would on its own, to rounding.
+	 * 
+	 */
+	template<typename T = double>
+	BasicEstimate<std::vector<T>> ode_solve_batch(BasicBatchOdeFunc<T> f, NoDeduce<T> t0, const std::vector<T> &y0, std::size_t count,
+												 NoDeduce<T> t1, const BasicOptions<T> &opts = BasicOptions<T>())
+	{
+		const std::size_t lanes = 64;
+		const std::size_t n = count > 0 ? y0.size() / count : 0;
+		const detail::RungeKuttaMethod<T> &method = detail::runge_kutta_method<T>(opts.ode);
+		const int stages = method.stages;
+		const T direction = t1 < t0 ? -1 : 1;
+		BasicEstimate<std::vector<T>> est = {y0, std::vector<T>(y0.size(), 0), 0};
+		const std::size_t blocks = (count + lanes - 1) / lanes;
+		std::vector<std::size_t> evaluations(blocks, 0);
+
+		detail::parallel_for(blocks, opts.threads, [&](std::size_t block){
+			const std::size_t first = block * lanes;
+			const std::size_t width = std::min(lanes, count - first);
+			//This block's solutions, in the same layout, at stride width.
+			std::vector<T> y(n * width);
+			std::vector<T> temp(n * width);
+			std::vector<T> error(n * width, 0);
+			std::vector<std::vector<T>> k(stages + 1, std::vector<T>(n * width));
+			std::vector<T> t(width, t0);
+			std::vector<T> times(width);
+			std::vector<T> next(width);
+			std::vector<T> steps(width);
+			//0 while a solution is going, 1 once it's at t1, -1 if it had to stop.
+			std::vector<int> state(width, 0);
+			for(std::size_t i = 0; i < n; ++i)
+			{
+				std::copy(y0.begin() + i * count + first, y0.begin() + i * count + first + width, y.begin() + i * width);
+			}
+			std::size_t calls = 0;
+			auto call = [&](std::vector<T> &out){
+				f(times, temp, out);
+				++calls;
+			};
+
+			std::copy(y.begin(), y.end(), temp.begin());
+			std::copy(t.begin(), t.end(), times.begin());
+			call(k[0]);
+
+			//The first steps, as OdeStepper guesses them.
+			const T left = detail::abs(t1 - t0);
+			if(method.order == 0)
+			{
+				std::fill(next.begin(), next.end(), opts.step);
+			}
+			else
+			{
+				std::vector<T> h0(width);
+				std::vector<T> d1(width, 0);
+				std::vector<T> d2(width, 0);
+				std::vector<T> d0(width, 0);
+				for(std::size_t i = 0; i < n; ++i)
+				{
+					for(std::size_t l = 0; l < width; ++l)
+					{
+						const T s = detail::ode_initial_scale(y[i * width + l], opts);
+						d0[l] += detail::pow(detail::ode_relative(y[i * width + l], s), 2);
+						d1[l] += detail::pow(detail::ode_relative(k[0][i * width + l], s), 2);
+					}
+				}
+				for(std::size_t l = 0; l < width; ++l)
+				{
+					d0[l] = detail::sqrt(d0[l] / T(n));
+					d1[l] = detail::sqrt(d1[l] / T(n));
+					h0[l] = detail::ode_trial_step(d0[l], d1[l], left);
+					times[l] = t0 + direction * h0[l];
+				}
+				for(std::size_t i = 0; i < n; ++i)
+				{
+					for(std::size_t l = 0; l < width; ++l)
+					{
+						temp[i * width + l] = y[i * width + l] + direction * h0[l] * k[0][i * width + l];
+					}
+				}
+				call(k[1]);
+				for(std::size_t i = 0; i < n; ++i)
+				{
+					for(std::size_t l = 0; l < width; ++l)
+					{
+						d2[l] += detail::pow(detail::ode_relative(k[1][i * width + l] - k[0][i * width + l],
+																  detail::ode_initial_scale(y[i * width + l], opts)), 2);
+					}
+				}
+				for(std::size_t l = 0; l < width; ++l)
+				{
+					d2[l] = detail::sqrt(d2[l] / T(n)) / h0[l];
+					next[l] = detail::ode_guessed_step(h0[l], d1[l], d2[l], method.order, left);
+				}
+			}
+
+			std::vector<bool> rejected(width, false);
+			std::vector<T> sum5(width);
+			std::vector<T> sum3(width);
+			std::vector<T> local(n * width, 0);
+			std::size_t going = width;
+			while(going > 0 && calls + stages <= opts.max_evaluations)
+			{
+				for(std::size_t l = 0; l < width; ++l)
+				{
+					const T remaining = detail::abs(t1 - t[l]);
+					steps[l] = state[l] != 0 ? T(0) : direction * std::min(next[l], remaining);
+				}
+				for(int s = 1; s <= stages; ++s)
+				{
+					for(std::size_t l = 0; l < width; ++l)
+					{
+						times[l] = t[l] + method.c[s] * steps[l];
+					}
+					for(std::size_t i = 0; i < n; ++i)
+					{
+						T *out = temp.data() + i * width;
+						const T *from = y.data() + i * width;
+						for(std::size_t l = 0; l < width; ++l)
+						{
+							out[l] = 0;
+						}
+						for(int j = 0; j < s; ++j)
+						{
+							const T a = method.a[s][j];
+							if(a == 0)
+							{
+								continue;
+							}
+							const T *stage = k[j].data() + i * width;
+							for(std::size_t l = 0; l < width; ++l)
+							{
+								out[l] += a * stage[l];
+							}
+						}
+						for(std::size_t l = 0; l < width; ++l)
+						{
+							out[l] = from[l] + steps[l] * out[l];
+						}
+					}
+					call(k[s]);
+				}
+
+				//The error of each solution's step, as OdeStepper has it, and each component's share to add up if the step stands.
+				std::fill(sum5.begin(), sum5.end(), T(0));
+				std::fill(sum3.begin(), sum3.end(), T(0));
+				if(method.order > 0)
+				{
+					for(std::size_t i = 0; i < n; ++i)
+					{
+						for(std::size_t l = 0; l < width; ++l)
+						{
+							T e5 = 0;
+							T e3 = 0;
+							for(int j = 0; j <= stages; ++j)
+							{
+								e5 += method.e[j] * k[j][i * width + l];
+								e3 += method.e3[j] * k[j][i * width + l];
+							}
+							const T s = detail::ode_scale(y[i * width + l], temp[i * width + l], opts);
+							sum5[l] += detail::pow(detail::ode_relative(e5, s), 2);
+							sum3[l] += detail::pow(detail::ode_relative(e3, s), 2);
+							local[i * width + l] = detail::ode_local_error(steps[l], e5, e3, method.tempered);
+						}
+					}
+				}
+
+				for(std::size_t l = 0; l < width; ++l)
+				{
+					if(state[l] != 0)
+					{
+						continue;
+					}
+					const T h = detail::abs(steps[l]);
+					const T norm = method.order > 0 ? detail::ode_error_norm(h, sum5[l], sum3[l], n, method.tempered) : T(0);
+					if(!(norm <= 1))
+					{
+						next[l] = detail::ode_next_step(h, norm, method.order, true);
+						rejected[l] = true;
+					}
+					else
+					{
+						for(std::size_t i = 0; i < n; ++i)
+						{
+							y[i * width + l] = temp[i * width + l];
+							k[0][i * width + l] = k[stages][i * width + l];
+							error[i * width + l] += method.order > 0 ? local[i * width + l] : T(0);
+						}
+						const bool last = h >= detail::abs(t1 - t[l]);
+						t[l] = last ? T(t1) : t[l] + steps[l];
+						if(last)
+						{
+							state[l] = 1;
+							--going;
+							continue;
+						}
+						if(method.order > 0)
+						{
+							next[l] = detail::ode_next_step(h, norm, method.order, bool(rejected[l]));
+						}
+						rejected[l] = false;
+					}
+					if(next[l] <= 10 * detail::epsilon<T>() * std::max(detail::abs(t[l]), std::numeric_limits<T>::min()))
+					{
+						state[l] = -1;
+						--going;
+					}
+				}
+			}
+
+			for(std::size_t i = 0; i < n; ++i)
+			{
+				for(std::size_t l = 0; l < width; ++l)
+				{
+					est.value[i * count + first + l] = y[i * width + l];
+					est.error[i * count + first + l] = state[l] == 1 ? error[i * width + l] : detail::infinity<T>();
+				}
+			}
+			evaluations[block] = calls * width;
+		});
+		for(std::size_t block = 0; block < blocks; ++block)
+		{
+			est.evaluations += evaluations[block];
+		}
+		return est;
+	}
+
+	namespace detail
+	{
+		/**
+		 * @brief The coefficients of a Rosenbrock method, in Hairer & Wanner's form that needs no products with the Jacobian.
+		 * 
+		 * @remarks Stage i solves (I / (h gamma) - J) u[i] = f(t + c[i] h, y + sum a[i][j] u[j]) + sum g[i][j] u[j] / h + h d[i] df/dt.
+		 * 		The step is y + sum m[j] u[j], and sum e[j] u[j] estimates its error.
+		 * 
+		 */
+		template<typename T>
+		struct RosenbrockMethod
+		{
+			static const int MAX_STAGES = 6;
+
+			int stages;
+			int evaluations;	//Of f a step, counting the one at its end, which the next step starts from.
+			int order;			//How fast the error estimate shrinks with the step, as h^order.
+			T gamma;
+			T c[MAX_STAGES];
+			T d[MAX_STAGES];
+			T a[MAX_STAGES][MAX_STAGES];
+			T g[MAX_STAGES][MAX_STAGES];
+			T m[MAX_STAGES];
+			T e[MAX_STAGES];
+			bool same[MAX_STAGES];	//Whether stage i evaluates f where stage i-1 did, and can reuse it.
+			bool continuous;		//Whether p and q below give dense output; if not, it is cubic Hermite.
+			T p[MAX_STAGES];		//Dense output is y + theta (delta + (1 - theta) (sum p[j] u[j] + theta sum q[j] u[j])),
+			T q[MAX_STAGES];		//with delta the step.
+		};
+
+		template<typename T>
+		RosenbrockMethod<T> ros34pw2_method()
+		{
+			RosenbrockMethod<T> m = {};
+			m.stages = 4;
+			m.evaluations = 4;
+			m.order = 3;
+			m.gamma = T(0.435866521508459L);
+			//Rang & Angermann's coefficients, as published. The ones above follow from them: with G the lower triangular gamma[i][j],
+			//a = alpha G^-1, g = diag(1 / gamma) - G^-1, m = b G^-1 and e = (b - bHat) G^-1.
+			const T alpha[4][4] = {
+				{0},
+				{T(0.87173304301691801L)},
+				{T(0.84457060015369423L), T(-0.11299064236484185L)},
+				{0, 0, 1}
+			};
+			const T G[4][4] = {
+				{m.gamma},
+				{T(-0.87173304301691801L), m.gamma},
+				{T(-0.90338057013044082L), T(0.054180672388095326L), m.gamma},
+				{T(0.24212380706095346L), T(-1.2232505839045147L), T(0.54526025533510214L), m.gamma}
+			};
+			const T b[4] = {T(0.24212380706095346L), T(-1.2232505839045147L), T(1.5452602553351020L), m.gamma};
+			const T bHat[4] = {T(0.37810903145819369L), T(-0.096042292212423178L), T(1) / 2, T(0.2179332607542295L)};
+			T inverse[4][4] = {};
+			for(int i = 0; i < 4; ++i)
+			{
+				inverse[i][i] = 1 / G[i][i];
+				for(int j = 0; j < i; ++j)
+				{
+					T sum = 0;
+					for(int k = j; k < i; ++k)
+					{
+						sum += G[i][k] * inverse[k][j];
+					}
+					inverse[i][j] = -sum / G[i][i];
+				}
+			}
+			for(int i = 0; i < 4; ++i)
+			{
+				for(int j = 0; j < 4; ++j)
+				{
+					m.c[i] += alpha[i][j];
+					m.d[i] += G[i][j];
+					m.m[j] += b[i] * inverse[i][j];
+					m.e[j] += (b[i] - bHat[i]) * inverse[i][j];
+					for(int k = 0; k < 4; ++k)
+					{
+						m.a[i][j] += alpha[i][k] * inverse[k][j];
+					}
+					if(j < i)
+					{
+						m.g[i][j] = -inverse[i][j];
+					}
+				}
+			}
+			return m;
+		}
+
+		template<typename T>
+		RosenbrockMethod<T> rodas4_method()
+		{
+			RosenbrockMethod<T> m = {};
+			m.stages = 6;
+			m.evaluations = 6;
+			m.order = 4;
+			m.gamma = T(0.25L);
+			//From Hairer's RODAS.
+			static const long double c[6] = {0.0L, 0.386L, 0.21L, 0.63L, 1.0L, 1.0L};
+			static const long double d[6] = {0.25L, -0.1043L, 0.1035L, -0.3620000000000023e-01L, 0.0L, 0.0L};
+			static const long double a[6][5] = {
+				{0.0L},
+				{0.1544000000000000e+01L},
+				{0.9466785280815826e+00L, 0.2557011698983284e+00L},
+				{0.3314825187068521e+01L, 0.2896124015972201e+01L, 0.9986419139977817e+00L},
+				{0.1221224509226641e+01L, 0.6019134481288629e+01L, 0.1253708332932087e+02L, -0.6878860361058950e+00L},
+				{0.1221224509226641e+01L, 0.6019134481288629e+01L, 0.1253708332932087e+02L, -0.6878860361058950e+00L, 1.0L}
+			};
+			static const long double g[6][5] = {
+				{0.0L},
+				{-0.5668800000000000e+01L},
+				{-0.2430093356833875e+01L, -0.2063599157091915e+00L},
+				{-0.1073529058151375e+00L, -0.9594562251023355e+01L, -0.2047028614809616e+02L},
+				{0.7496443313967647e+01L, -0.1024680431464352e+02L, -0.3399990352819905e+02L, 0.1170890893206160e+02L},
+				{0.8083246795921522e+01L, -0.7981132988064893e+01L, -0.3152159432874371e+02L, 0.1631930543123136e+02L,
+				 -0.6058818238834054e+01L}
+			};
+			for(int i = 0; i < 6; ++i)
+			{
+				m.c[i] = T(c[i]);
+				m.d[i] = T(d[i]);
+				for(int j = 0; j < 5; ++j)
+				{
+					m.a[i][j] = T(a[i][j]);
+					m.g[i][j] = T(g[i][j]);
+				}
+			}
+			//Stiffly accurate: the step is where the last stage is taken, plus that stage, which is also the error estimate.
+			for(int j = 0; j < 5; ++j)
+			{
+				m.m[j] = m.a[5][j];
+			}
+			m.m[5] = 1;
+			m.e[5] = 1;
+			//Third order dense output: the smallest p and q that satisfy the order conditions. Unlike a Hermite cubic through
+			//f at the ends, which carries the error of the stiff components times the Jacobian, they are exact in the stiff limit
+			//for solutions that are linear in t.
+			static const long double p[6] = {0.10466220647696582e+02L, -0.6175298240219212e+01L, -0.3336502162878561e+02L,
+											 -0.5321573762439213e+01L, -0.16771218667615112e+00L, -0.6669260053996978e-01L};
+			static const long double q[6] = {-0.13235133568988795e+01L, 0.35887225108167438e+01L, 0.1369731556110794e+02L,
+											 0.1968204595225866e+02L, -0.4323551984443687e+01L, -0.171930812617778e+01L};
+			m.continuous = true;
+			for(int j = 0; j < 6; ++j)
+			{
+				m.p[j] = T(p[j]);
+				m.q[j] = T(q[j]);
+			}
+			return m;
+		}
+
+		/**
+		 * @brief The coefficients of a Rosenbrock method, in the scalar type of the solution.
+		 * 
+		 */
+		template<typename T>
+		const RosenbrockMethod<T> &rosenbrock_method(Stiff method)
+		{
+			static const RosenbrockMethod<T> ros34pw2 = ros34pw2_method<T>();
+			static const RosenbrockMethod<T> rodas4 = rodas4_method<T>();
+			return method == Stiff::ROS34PW2 ? ros34pw2 : rodas4;
+		}
+
+		/**
+		 * @brief Where a Jacobian's entries are stored, and which of its columns can be found together.
+		 * 
+		 * @remarks Entries are stored row by row: all n of each row when dense, or else the columns the Sparsity lists for it, in that order.
+		 * 		Columns that share no row can be perturbed at once and still be told apart, so a banded Jacobian takes as many
+		 * 		evaluations as it has diagonals, however large it is. That's Curtis, Powell & Reid's grouping, done greedily.
+		 * 
+		 */
+		struct JacobianLayout
+		{
+			std::size_t entries;
+			//For each column, the rows it can be nonzero in, each with where its entry is stored.
+			std::vector<std::vector<std::pair<std::size_t, std::size_t>>> columns;
+			std::vector<std::vector<std::size_t>> groups;
+		};
+
+		inline JacobianLayout jacobian_layout(std::size_t n, const Sparsity &sparsity)
+		{
+			JacobianLayout layout;
+			layout.columns.resize(n);
+			if(sparsity.empty())
+			{
+				layout.entries = n * n;
+				for(std::size_t j = 0; j < n; ++j)
+				{
+					for(std::size_t i = 0; i < n; ++i)
+					{
+						layout.columns[j].emplace_back(i, i * n + j);
+					}
+					layout.groups.push_back(std::vector<std::size_t>(1, j));
+				}
+				return layout;
+			}
+			if(sparsity.size() != n)
+			{
+				throw std::invalid_argument("Sparsity: needs a row for every component");
+			}
+			std::size_t k = 0;
+			std::vector<std::size_t> seen(n, n);
+			for(std::size_t i = 0; i < n; ++i)
+			{
+				for(std::size_t j : sparsity[i])
+				{
+					if(j >= n || seen[j] == i)
+					{
+						throw std::invalid_argument("Sparsity: columns must be in range, and listed once a row");
+					}
+					seen[j] = i;
+					layout.columns[j].emplace_back(i, k++);
+				}
+			}
+			layout.entries = k;
+			//The rows each group covers so far. Every column joins the first group it shares none with.
+			std::vector<std::vector<bool>> covered;
+			for(std::size_t j = 0; j < n; ++j)
+			{
+				std::size_t group = 0;
+				for(; group < covered.size(); ++group)
+				{
+					bool fits = true;
+					for(const auto &entry : layout.columns[j])
+					{
+						if(covered[group][entry.first])
+						{
+							fits = false;
+							break;
+						}
+					}
+					if(fits)
+					{
+						break;
+					}
+				}
+				if(group == covered.size())
+				{
+					covered.emplace_back(n, false);
+					layout.groups.emplace_back();
+				}
+				for(const auto &entry : layout.columns[j])
+				{
+					covered[group][entry.first] = true;
+				}
+				layout.groups[group].push_back(j);
+			}
+			return layout;
+		}
+
+		/**
+		 * @brief The matrix a I - b J of an implicit step, with J stored as a JacobianLayout has it, factored into LU to solve with.
+		 * 
+		 * @remarks Dense matrices are factored with partial pivoting. Sparse ones aren't pivoted at all, so their factors fit a pattern
+		 * 		worked out once, fill-in and all, and factoring only touches entries in it. The steps of stiff solvers are small enough
+		 * 		that a I usually dominates the diagonal anyway; a pivot too small to trust fails the factorization, for a smaller step.
+		 * 
+		 */
+		template<typename T>
+		class IterationMatrix
+		{
+		public:
+			IterationMatrix(std::size_t n, const Sparsity &sparsity)
+				: mN(n), mDense(sparsity.empty())
+			{
+				if(mDense)
+				{
+					mJacobian.resize(n * n);
+					mLU.resize(n * n);
+					mPivots.resize(n);
+					return;
+				}
+				//Row i of the factors has the columns of row i, the diagonal, and those of U's rows it gets combined with.
+				std::vector<std::size_t> row;
+				std::vector<std::size_t> merged;
+				mStart.push_back(0);
+				for(std::size_t i = 0; i < n; ++i)
+				{
+					row.assign(sparsity[i].begin(), sparsity[i].end());
+					row.push_back(i);
+					std::sort(row.begin(), row.end());
+					row.erase(std::unique(row.begin(), row.end()), row.end());
+					for(std::size_t p = 0; p < row.size() && row[p] < i; ++p)
+					{
+						const std::size_t k = row[p];
+						const auto upper = mColumns.begin() + mDiagonal[k] + 1;
+						const auto end = mColumns.begin() + mStart[k + 1];
+						merged.resize((row.size() - p - 1) + (end - upper));
+						merged.erase(std::set_union(row.begin() + p + 1, row.end(), upper, end, merged.begin()), merged.end());
+						row.resize(p + 1);
+						row.insert(row.end(), merged.begin(), merged.end());
+					}
+					mDiagonal.push_back(mColumns.size() + (std::lower_bound(row.begin(), row.end(), i) - row.begin()));
+					mColumns.insert(mColumns.end(), row.begin(), row.end());
+					mStart.push_back(mColumns.size());
+				}
+				for(std::size_t i = 0; i < n; ++i)
+				{
+					for(std::size_t j : sparsity[i])
+					{
+						mJacobianAt.push_back(std::lower_bound(mColumns.begin() + mStart[i], mColumns.begin() + mStart[i + 1], j) - mColumns.begin());
+					}
+				}
+				mJacobian.resize(mJacobianAt.size());
+				mLU.resize(mColumns.size());
+				mRow.resize(n);
+			}
+
+			/**
+			 * @brief The Jacobian, to be written before factor().
+			 * 
+			 */
+			std::vector<T> &jacobian()
+			{
+				return mJacobian;
+			}
+
+			/**
+			 * @brief Factors a I - b J.
+			 * 
+			 * @return bool False if it's singular, or too close to it without pivoting, in which case solve() can't be used.
+			 */
+			bool factor(T a, T b)
+			{
+				const std::size_t n = mN;
+				if(mDense)
+				{
+					for(std::size_t k = 0; k < n * n; ++k)
+					{
+						mLU[k] = -b * mJacobian[k];
+					}
+					for(std::size_t i = 0; i < n; ++i)
+					{
+						mLU[i * n + i] += a;
+					}
+					for(std::size_t k = 0; k < n; ++k)
+					{
+						std::size_t pivot = k;
+						for(std::size_t i = k + 1; i < n; ++i)
+						{
+							if(detail::abs(mLU[i * n + k]) > detail::abs(mLU[pivot * n + k]))
+							{
+								pivot = i;
+							}
+						}
+						mPivots[k] = pivot;
+						if(!(detail::abs(mLU[pivot * n + k]) > 0) || !detail::isfinite(mLU[pivot * n + k]))
+						{
+							return false;
+						}
+						if(pivot != k)
+						{
+							std::swap_ranges(mLU.begin() + k * n, mLU.begin() + (k + 1) * n, mLU.begin() + pivot * n);
+						}
+						for(std::size_t i = k + 1; i < n; ++i)
+						{
+							const T l = mLU[i * n + k] /= mLU[k * n + k];
+							if(l == 0)
+							{
+								continue;
+							}
+							for(std::size_t j = k + 1; j < n; ++j)
+							{
+								mLU[i * n + j] -= l * mLU[k * n + j];
+							}
+						}
+					}
+					return true;
+				}
+
+				std::fill(mLU.begin(), mLU.end(), T(0));
+				for(std::size_t k = 0; k < mJacobian.size(); ++k)
+				{
+					mLU[mJacobianAt[k]] -= b * mJacobian[k];
+				}
+				for(std::size_t i = 0; i < n; ++i)
+				{
+					mLU[mDiagonal[i]] += a;
+				}
+				for(std::size_t i = 0; i < n; ++i)
+				{
+					//Row i goes out to a dense row, gets combined with the rows of U above it, left to right, and comes back.
+					T largest = 0;
+					for(std::size_t p = mStart[i]; p < mStart[i + 1]; ++p)
+					{
+						mRow[mColumns[p]] = mLU[p];
+						largest = std::max(largest, detail::abs(mLU[p]));
+					}
+					for(std::size_t p = mStart[i]; p < mDiagonal[i]; ++p)
+					{
+						const std::size_t k = mColumns[p];
+						const T l = mRow[k] /= mLU[mDiagonal[k]];
+						if(l == 0)
+						{
+							continue;
+						}
+						for(std::size_t q = mDiagonal[k] + 1; q < mStart[k + 1]; ++q)
+						{
+							mRow[mColumns[q]] -= l * mLU[q];
+						}
+					}
+					for(std::size_t p = mStart[i]; p < mStart[i + 1]; ++p)
+					{
+						mLU[p] = mRow[mColumns[p]];
+					}
+					const T pivot = mLU[mDiagonal[i]];
+					if(!(detail::abs(pivot) > detail::epsilon<T>() * largest) || !detail::isfinite(pivot))
+					{
+						return false;
+					}
+				}
+				return true;
+			}
+
+			/**
+			 * @brief Solves (a I - b J) x = rhs in place, with the last successful factor().
+			 * 
+			 */
+			void solve(T *x) const
+			{
+				const std::size_t n = mN;
+				if(mDense)
+				{
+					for(std::size_t k = 0; k < n; ++k)
+					{
+						std::swap(x[k], x[mPivots[k]]);
+					}
+					for(std::size_t i = 0; i < n; ++i)
+					{
+						for(std::size_t j = 0; j < i; ++j)
+						{
+							x[i] -= mLU[i * n + j] * x[j];
+						}
+					}
+					for(std::size_t i = n; i-- > 0;)
+					{
+						for(std::size_t j = i + 1; j < n; ++j)
+						{
+							x[i] -= mLU[i * n + j] * x[j];
+						}
+						x[i] /= mLU[i * n + i];
+					}
+					return;
+				}
+				for(std::size_t i = 0; i < n; ++i)
+				{
+					for(std::size_t p = mStart[i]; p < mDiagonal[i]; ++p)
+					{
+						x[i] -= mLU[p] * x[mColumns[p]];
+					}
+				}
+				for(std::size_t i = n; i-- > 0;)
+				{
+					for(std::size_t p = mDiagonal[i] + 1; p < mStart[i + 1]; ++p)
+					{
+						x[i] -= mLU[p] * x[mColumns[p]];
+					}
+					x[i] /= mLU[mDiagonal[i]];
+				}
+			}
+		private:
+			std::size_t mN;
+			bool mDense;
+			std::vector<T> mJacobian;
+			//L below the diagonal, without its unit diagonal, and U on and above it. Dense, n by n and row-major;
+			//sparse, row i has the columns mColumns[mStart[i]] to mColumns[mStart[i + 1] - 1], in order.
+			std::vector<T> mLU;
+			std::vector<std::size_t> mPivots;
+			std::vector<std::size_t> mStart;
+			std::vector<std::size_t> mColumns;
+			std::vector<std::size_t> mDiagonal;
+			//Where each entry of the Jacobian goes in mLU.
+			std::vector<std::size_t> mJacobianAt;
+			std::vector<T> mRow;
+		};
+
+		/**
+		 * @brief A state like State, with scalars of type S instead, for evaluating f on jets.
+		 * 
+		 */
+		template<typename State, typename S>
+		struct OdeRebind
+		{
+			typedef S type;
+
+			static type like(const State &)
+			{
+				return type();
+			}
+
+			static S &at(type &y, std::size_t)
+			{
+				return y;
+			}
+
+			static const S &at(const type &y, std::size_t)
+			{
+				return y;
+			}
+		};
+
+		template<typename T, std::size_t N, typename S>
+		struct OdeRebind<std::array<T, N>, S>
+		{
+			typedef std::array<S, N> type;
+
+			static type like(const std::array<T, N> &)
+			{
+				return type();
+			}
+
+			static S &at(type &y, std::size_t i)
+			{
+				return y[i];
+			}
+
+			static const S &at(const type &y, std::size_t i)
+			{
+				return y[i];
+			}
+		};
+
+		template<typename T, typename Allocator, typename S>
+		struct OdeRebind<std::vector<T, Allocator>, S>
+		{
+			typedef std::vector<S> type;
+
+			static type like(const std::vector<T, Allocator> &y)
+			{
+				return type(y.size());
+			}
+
+			static S &at(type &y, std::size_t i)
+			{
+				return y[i];
+			}
+
+			static const S &at(const type &y, std::size_t i)
+			{
+				return y[i];
+			}
+		};
+	}
+
+	/**
+	 * @brief The Jacobian of y' = f(t, y) for the stiff solvers: writes df/dy at (t, y), laid out as its Sparsity says
+	 * 		(row by row, all of each row if dense), and df/dt, one per component. Both come already sized.
+	 * 
+	 * @see ode_jacobian()
+	 * 
+	 */
+	template<typename State>
+	using OdeJacobian = std::function<void(OdeScalar<State> t, const State &y, std::vector<OdeScalar<State>> &jacobian,
+										   std::vector<OdeScalar<State>> &dfdt)>;
+
+	/**
+	 * @brief The exact Jacobian of an ODE by forward-mode AD, for the stiff solvers.
+	 * 
+	 * @param fx The right side, as a template/generic callable taking t and the state and returning y'. It gets evaluated on
+	 * 		Jet<1, T> in place of T, one pass per group of columns that share no row, and one more for df/dt.
+	 * 		Starting the result as a copy of y, `auto dydt = y;`, gives it the right type either way.
+	 * @param sparsity Which entries can be nonzero, or empty for all of them. The stiff solver needs the same one.
+	 * @return OdeJacobian<State> The Jacobian, for StiffStepper, stiff_solve() and stiff_solve_at().
+	 * 
+	 */
+	template<typename State, typename F>
+	OdeJacobian<State> ode_jacobian(F &&fx, const Sparsity &sparsity = Sparsity())
+	{
+		typedef OdeScalar<State> T;
+		typedef detail::OdeState<State> Traits;
+		typedef detail::OdeRebind<State, Jet<1, T>> Rebind;
+		typedef typename Rebind::type JetState;
+		detail::JacobianLayout layout = detail::jacobian_layout(0, Sparsity());
+		return [fx, sparsity, layout](T t, const State &y, std::vector<T> &jacobian, std::vector<T> &dfdt) mutable {
+			const std::size_t n = Traits::size(y);
+			if(layout.columns.size() != n)
+			{
+				layout = detail::jacobian_layout(n, sparsity);
+			}
+			JetState point = Rebind::like(y);
+			for(std::size_t i = 0; i < n; ++i)
+			{
+				Rebind::at(point, i) = Jet<1, T>(Traits::at(y, i));
+			}
+			for(const auto &group : layout.groups)
+			{
+				for(std::size_t j : group)
+				{
+					Rebind::at(point, j)[1] = 1;
+				}
+				const JetState out = fx(Jet<1, T>(t), point);
+				for(std::size_t j : group)
+				{
+					Rebind::at(point, j)[1] = 0;
+					for(const auto &entry : layout.columns[j])
+					{
+						jacobian[entry.second] = Rebind::at(out, entry.first)[1];
+					}
+				}
+			}
+			const JetState out = fx(Jet<1, T>::variable(t), point);
+			for(std::size_t i = 0; i < n; ++i)
+			{
+				dfdt[i] = Rebind::at(out, i)[1];
+			}
+		};
+	}
+
+	/**
+	 * @brief Steps the solution of a stiff y' = f(t, y) along, one implicit step at a time, with interpolation in between.
+	 * 
+	 * @remarks Stiff problems have components that settle far faster than the solution itself changes, and explicit methods can only
+	 * 		stay stable on them with steps on the fast time-scale. Implicit ones step on the solution's own time-scale instead,
+	 * 		for the price of a linear system with the Jacobian each step; see Stiff for how each method goes about it.
+	 * 		The Jacobian comes from forward differences, one evaluation for each group of columns that share no row,
+	 * 		or from an OdeJacobian such as ode_jacobian() makes. Steps are sized as OdeStepper sizes them.
+	 * 		The state can be a scalar, a std::array, or a std::vector.
+	 * 
+	 */
+	template<typename State>
+	class StiffStepper
+	{
+	public:
+		typedef OdeScalar<State> T;
+
+		/**
+		 * @brief Starts a solution.
+		 * 
+		 * @param f The right side.
+		 * @param t0 Where the solution starts.
+		 * @param y0 The solution there.
+		 * @param opts The method (see Stiff), tolerances and evaluation budget.
+		 * @param sparsity Which entries of the Jacobian can be nonzero, or empty for all of them.
+		 * @param jacobian Where the Jacobian comes from, laid out as sparsity says, or nullptr for forward differences of f.
+		 * 
+		 * @throws std::invalid_argument If sparsity doesn't have a row for each component, or lists a column twice or out of range.
+		 */
+		StiffStepper(OdeFunc<State> f, T t0, const State &y0, const BasicOptions<T> &opts = BasicOptions<T>(),
+					 const Sparsity &sparsity = Sparsity(), OdeJacobian<State> jacobian = nullptr)
+			: mF(f), mJacobianFunc(jacobian), mMethod(&detail::rosenbrock_method<T>(opts.stiff)), mOpts(opts),
+			  mBDF(opts.stiff == Stiff::BDF), mN(detail::OdeState<State>::size(y0)), mLayout(detail::jacobian_layout(mN, sparsity)),
+			  mMatrix(mN, sparsity), mT(t0), mTOld(t0), mH(0), mY(y0), mYOld(y0), mTemp(y0), mPoint(y0), mError(y0),
+			  mDfdt(mN, 0), mDelta(mN, 0), mWork(mN, 0), mOrder(1), mEqualSteps(0), mFactored(false), mJacobianCurrent(false),
+			  mEvaluations(0), mJacobians(0), mFactorizations(0), mSteps(0), mRejected(0)
+		{
+			for(std::size_t i = 0; i < mN; ++i)
+			{
+				Traits::at(mError, i) = 0;
+			}
+			if(mBDF)
+			{
+				mD.assign((MAX_ORDER + 3) * mN, 0);
+				mPredict.assign(mN, 0);
+				mPsi.assign(mN, 0);
+				//Shampine & Reichelt's NDF coefficients, as in ode15s.
+				const T kappa[MAX_ORDER + 1] = {0, T(-0.1850), T(-1) / 9, T(-0.0823), T(-0.0415), 0};
+				T gamma = 0;
+				for(int k = 0; k <= MAX_ORDER; ++k)
+				{
+					gamma += k > 0 ? T(1) / k : T(0);
+					mGamma[k] = gamma;
+					mAlpha[k] = (1 - kappa[k]) * gamma;
+					mErrorConst[k] = kappa[k] * gamma + T(1) / (k + 1);
+				}
+			}
+			else
+			{
+				mStages.assign(mMethod->stages * mN, 0);
+			}
+			mF0 = mF(mT, mY);
+			mF0Old = mF0;
+			mEvaluations = 1;
+		}
+
+		/**
+		 * @brief Takes one step towards a point, retrying it smaller until it's accurate enough.
+		 * 
+		 * @param end Where the solution is headed. The step is cut short to land on it.
+		 * @return bool Whether a step was taken. False once the solution is at end, or when it can't go on:
+		 * 		the budget of max_evaluations ran out, or the step shrank to nothing, as it does at a singularity or once f isn't finite.
+		 */
+		bool step(T end)
+		{
+			if(mT == end)
+			{
+				return false;
+			}
+			return mBDF ? mStepBDF(end) : mStepRosenbrock(end);
+		}
+
+		/**
+		 * @brief The solution in the last step, between t of the step before and t(). Only good if the last call to step() took a step.
+		 * 
+		 * @param t Where to interpolate. Outside the last step, the interpolant is extrapolated, which quickly goes wrong.
+		 * @param out Where the solution goes, already sized like the state.
+		 * 
+		 * @remarks Rodas4 steps are interpolated by its own third order continuous output, from the stages of the step.
+		 * 		ROS34PW2 has none, so its steps are interpolated by cubic Hermite from both ends,
+		 * 		and BDF steps by the polynomial the step came from.
+		 * 
+		 */
+		void interpolate(T t, State &out) const
+		{
+			if(mT == mTOld)
+			{
+				out = mY;
+				return;
+			}
+			if(mBDF)
+			{
+				//In terms of the differences, the polynomial through the last order+1 solutions, a step apart.
+				const T h = (mT > mTOld ? 1 : -1) * mH;
+				T products[MAX_ORDER];
+				T product = 1;
+				for(int k = 0; k < mOrder; ++k)
+				{
+					product *= (t - (mT - h * k)) / (h * (k + 1));
+					products[k] = product;
+				}
+				for(std::size_t i = 0; i < mN; ++i)
+				{
+					T sum = mD[i];
+					for(int k = 0; k < mOrder; ++k)
+					{
+						sum += mD[(k + 1) * mN + i] * products[k];
+					}
+					Traits::at(out, i) = sum;
+				}
+				return;
+			}
+			const T h = mT - mTOld;
+			const T theta = (t - mTOld) / h;
+			if(mMethod->continuous)
+			{
+				for(std::size_t i = 0; i < mN; ++i)
+				{
+					T p = 0;
+					T q = 0;
+					for(int j = 0; j < mMethod->stages; ++j)
+					{
+						p += mMethod->p[j] * mStages[j * mN + i];
+						q += mMethod->q[j] * mStages[j * mN + i];
+					}
+					const T y0 = Traits::at(mYOld, i);
+					Traits::at(out, i) = y0 + theta * ((Traits::at(mY, i) - y0) + (1 - theta) * (p + theta * q));
+				}
+				return;
+			}
+			for(std::size_t i = 0; i < mN; ++i)
+			{
+				const T y0 = Traits::at(mYOld, i);
+				const T y1 = Traits::at(mY, i);
+				Traits::at(out, i) = (1 - theta) * y0 + theta * y1 + theta * (theta - 1) * ((1 - 2 * theta) * (y1 - y0)
+									 + (theta - 1) * h * Traits::at(mF0Old, i) + theta * h * Traits::at(mF0, i));
+			}
+		}
+
+		/**
+		 * @brief Where the solution is.
+		 * 
+		 */
+		T t() const
+		{
+			return mT;
+		}
+
+		/**
+		 * @brief The solution at t().
+		 * 
+		 */
+		const State &y() const
+		{
+			return mY;
+		}
+
+		/**
+		 * @brief The sum of the error estimates of the steps so far, component by component.
+		 * 
+		 * @remarks That's the error made along the way, not how far off the solution is: errors can grow or shrink as the solution goes on.
+		 * 
+		 */
+		const State &error() const
+		{
+			return mError;
+		}
+
+		/**
+		 * @brief How many times f was evaluated, including for finite difference Jacobians, but not by an OdeJacobian.
+		 * 
+		 */
+		std::size_t evaluations() const
+		{
+			return mEvaluations;
+		}
+
+		/**
+		 * @brief How many times the Jacobian was found.
+		 * 
+		 */
+		std::size_t jacobians() const
+		{
+			return mJacobians;
+		}
+
+		/**
+		 * @brief How many times the iteration matrix was factored.
+		 * 
+		 */
+		std::size_t factorizations() const
+		{
+			return mFactorizations;
+		}
+
+		/**
+		 * @brief How many steps were taken, not counting rejected ones.
+		 * 
+		 */
+		std::size_t steps() const
+		{
+			return mSteps;
+		}
+
+		/**
+		 * @brief How many steps were rejected, as not accurate enough or for Newton not converging, and retried smaller.
+		 * 
+		 */
+		std::size_t rejected() const
+		{
+			return mRejected;
+		}
+	private:
+		typedef detail::OdeState<State> Traits;
+
+		static const int MAX_ORDER = 5;
+		static const int NEWTON_ITERATIONS = 4;
+
+		OdeFunc<State> mF;
+		OdeJacobian<State> mJacobianFunc;
+		const detail::RosenbrockMethod<T> *mMethod;
+		BasicOptions<T> mOpts;
+		bool mBDF;
+		std::size_t mN;
+		detail::JacobianLayout mLayout;
+		detail::IterationMatrix<T> mMatrix;
+		T mT;
+		T mTOld;
+		//The next step to try, without its sign. 0 until the first step.
+		T mH;
+		State mY;
+		State mYOld;
+		//What f is evaluated on, other than the solution.
+		State mTemp;
+		//The new solution while BDF solves for it.
+		State mPoint;
+		State mError;
+		//f at the solution, and at the one before, for ROS34PW2's Hermite interpolation.
+		State mF0;
+		State mF0Old;
+		State mStageF;
+		std::vector<T> mDfdt;
+		std::vector<T> mDelta;
+		std::vector<T> mWork;
+		//The stages of a Rosenbrock step, one after another.
+		std::vector<T> mStages;
+		//The backward differences of BDF, D^k y at the solution for k = 0 to MAX_ORDER + 2, one after another, for steps of mH.
+		std::vector<T> mD;
+		std::vector<T> mPredict;
+		std::vector<T> mPsi;
+		T mGamma[MAX_ORDER + 1];
+		T mAlpha[MAX_ORDER + 1];
+		T mErrorConst[MAX_ORDER + 1];
+		int mOrder;
+		//How many steps BDF took since it last changed its step or order.
+		int mEqualSteps;
+		//Whether mMatrix is factored for the step BDF is trying, or close enough to it.
+		bool mFactored;
+		//Whether the Jacobian is at the solution, rather than kept from a step before.
+		bool mJacobianCurrent;
+		std::size_t mEvaluations;
+		std::size_t mJacobians;
+		std::size_t mFactorizations;
+		std::size_t mSteps;
+		std::size_t mRejected;
+
+		//How much a component is allowed to be off by.
+		T mScale(std::size_t i, T other) const
+		{
+			return detail::ode_scale(Traits::at(mY, i), other, mOpts);
+		}
+
+		//The evaluations mJacobian() takes.
+		std::size_t mJacobianCost() const
+		{
+			return mJacobianFunc ? 0 : mLayout.groups.size() + (mBDF ? 0 : 1);
+		}
+
+		//The Jacobian at (t, y), where f is f0, and df/dt there for Rosenbrock steps.
+		void mJacobian(T t, const State &y, const State &f0)
+		{
+			++mJacobians;
+			mJacobianCurrent = true;
+			std::vector<T> &jacobian = mMatrix.jacobian();
+			if(mJacobianFunc)
+			{
+				mJacobianFunc(t, y, jacobian, mDfdt);
+				return;
+			}
+			//Hairer's perturbations, which stay accurate for components far smaller than 1.
+			const T eps = detail::epsilon<T>();
+			mTemp = y;
+			for(const auto &group : mLayout.groups)
+			{
+				for(std::size_t j : group)
+				{
+					const T yj = Traits::at(y, j);
+					Traits::at(mTemp, j) = yj + detail::sqrt(eps * std::max(T(1e-5), detail::abs(yj)));
+					//The difference it actually makes, after rounding.
+					mDelta[j] = Traits::at(mTemp, j) - yj;
+				}
+				const State f1 = mF(t, mTemp);
+				++mEvaluations;
+				for(std::size_t j : group)
+				{
+					Traits::at(mTemp, j) = Traits::at(y, j);
+					for(const auto &entry : mLayout.columns[j])
+					{
+						jacobian[entry.second] = (Traits::at(f1, entry.first) - Traits::at(f0, entry.first)) / mDelta[j];
+					}
+				}
+			}
+			if(!mBDF)
+			{
+				const T dt = (t + detail::sqrt(eps * std::max(T(1e-5), detail::abs(t)))) - t;
+				const State f1 = mF(t + dt, y);
+				++mEvaluations;
+				for(std::size_t i = 0; i < mN; ++i)
+				{
+					mDfdt[i] = (Traits::at(f1, i) - Traits::at(f0, i)) / dt;
+				}
+			}
+		}
+
+		bool mStepRosenbrock(T end)
+		{
+			const detail::RosenbrockMethod<T> &method = *mMethod;
+			const std::size_t n = mN;
+			const T direction = end > mT ? 1 : -1;
+			const T left = detail::abs(end - mT);
+			const T smallest = 10 * detail::epsilon<T>() * std::max(detail::abs(mT), std::numeric_limits<T>::min());
+			if(mH == 0)
+			{
+				mH = detail::ode_initial_step(mF, mT, mY, mF0, mTemp, direction, left, method.order, mOpts);
+				++mEvaluations;
+			}
+
+			bool rejected = false;
+			while(mH > smallest)
+			{
+				//The Jacobian stays the same for every try at a step; only the matrix changes with h.
+				if(mEvaluations + method.evaluations + (mJacobianCurrent ? 0 : mJacobianCost()) > mOpts.max_evaluations)
+				{
+					break;
+				}
+				if(!mJacobianCurrent)
+				{
+					mJacobian(mT, mY, mF0);
+				}
+				const bool last = mH >= left;
+				const T h = direction * (last ? left : mH);
+				++mFactorizations;
+				if(!mMatrix.factor(1 / (h * method.gamma), 1))
+				{
+					mH = detail::abs(h) / 2;
+					rejected = true;
+					++mRejected;
+					continue;
+				}
+				for(int s = 0; s < method.stages; ++s)
+				{
+					if(s > 0 && !method.same[s])
+					{
+						for(std::size_t i = 0; i < n; ++i)
+						{
+							T sum = 0;
+							for(int j = 0; j < s; ++j)
+							{
+								sum += method.a[s][j] * mStages[j * n + i];
+							}
+							Traits::at(mTemp, i) = Traits::at(mY, i) + sum;
+						}
+						mStageF = mF(mT + method.c[s] * h, mTemp);
+						++mEvaluations;
+					}
+					const State &f = s == 0 ? mF0 : mStageF;
+					T *u = mStages.data() + s * n;
+					for(std::size_t i = 0; i < n; ++i)
+					{
+						T sum = 0;
+						for(int j = 0; j < s; ++j)
+						{
+							sum += method.g[s][j] * mStages[j * n + i];
+						}
+						u[i] = Traits::at(f, i) + sum / h + h * method.d[s] * mDfdt[i];
+					}
+					mMatrix.solve(u);
+				}
+
+				//The new solution, and the RMS of its scaled error estimate.
+				T sum = 0;
+				for(std::size_t i = 0; i < n; ++i)
+				{
+					T y = Traits::at(mY, i);
+					T error = 0;
+					for(int j = 0; j < method.stages; ++j)
+					{
+						y += method.m[j] * mStages[j * n + i];
+						error += method.e[j] * mStages[j * n + i];
+					}
+					Traits::at(mTemp, i) = y;
+					mWork[i] = error;
+					sum += detail::pow(detail::ode_relative(error, mScale(i, y)), 2);
+				}
+				const T norm = detail::sqrt(sum / T(n));
+				if(!(norm <= 1))
+				{
+					//Including NAN, where the stages weren't finite.
+					mH = detail::ode_next_step(detail::abs(h), norm, method.order, true);
+					rejected = true;
+					++mRejected;
+					continue;
+				}
+				for(std::size_t i = 0; i < n; ++i)
+				{
+					Traits::at(mError, i) += detail::abs(mWork[i]);
+				}
+				mTOld = mT;
+				mT = last ? end : mT + h;
+				std::swap(mYOld, mY);
+				std::swap(mY, mTemp);
+				std::swap(mF0Old, mF0);
+				mF0 = mF(mT, mY);
+				++mEvaluations;
+				mJacobianCurrent = false;
+				++mSteps;
+				mH = detail::ode_next_step(detail::abs(h), norm, method.order, rejected);
+				return true;
+			}
+			return false;
+		}
+
+		//Rescales the differences to steps factor times as long, with Shampine & Reichelt's matrices: D <- (R U)^T D.
+		void mRescale(T factor)
+		{
+			const int order = mOrder;
+			auto changes = [order](T ratio, T (&out)[MAX_ORDER + 1][MAX_ORDER + 1]){
+				for(int j = 0; j <= order; ++j)
+				{
+					T product = 1;
+					out[0][j] = 1;
+					for(int i = 1; i <= order; ++i)
+					{
+						product *= j == 0 ? T(0) : (i - 1 - ratio * j) / i;
+						out[i][j] = product;
+					}
+				}
+			};
+			T R[MAX_ORDER + 1][MAX_ORDER + 1];
+			T U[MAX_ORDER + 1][MAX_ORDER + 1];
+			T RU[MAX_ORDER + 1][MAX_ORDER + 1];
+			changes(factor, R);
+			changes(1, U);
+			for(int i = 0; i <= order; ++i)
+			{
+				for(int j = 0; j <= order; ++j)
+				{
+					RU[i][j] = 0;
+					for(int k = 0; k <= order; ++k)
+					{
+						RU[i][j] += R[i][k] * U[k][j];
+					}
+				}
+			}
+			T old[MAX_ORDER + 1];
+			for(std::size_t i = 0; i < mN; ++i)
+			{
+				for(int k = 0; k <= order; ++k)
+				{
+					old[k] = mD[k * mN + i];
+				}
+				for(int j = 0; j <= order; ++j)
+				{
+					T sum = 0;
+					for(int k = 0; k <= order; ++k)
+					{
+						sum += RU[k][j] * old[k];
+					}
+					mD[j * mN + i] = sum;
+				}
+			}
+		}
+
+		//Simplified Newton iterations for the BDF step to t, from mPredict, with the matrix as last factored.
+		//Leaves the solution in mPoint and its difference from the prediction in mDelta.
+		bool mNewton(T t, T c, T tolerance, int &iterations)
+		{
+			const std::size_t n = mN;
+			for(std::size_t i = 0; i < n; ++i)
+			{
+				Traits::at(mPoint, i) = mPredict[i];
+				mDelta[i] = 0;
+			}
+			T previous = 0;
+			for(int k = 0; k < NEWTON_ITERATIONS; ++k)
+			{
+				iterations = k + 1;
+				const State f = mF(t, mPoint);
+				++mEvaluations;
+				for(std::size_t i = 0; i < n; ++i)
+				{
+					if(!detail::isfinite(Traits::at(f, i)))
+					{
+						return false;
+					}
+					mWork[i] = c * Traits::at(f, i) - mPsi[i] - mDelta[i];
+				}
+				mMatrix.solve(mWork.data());
+				T sum = 0;
+				for(std::size_t i = 0; i < n; ++i)
+				{
+					sum += detail::pow(detail::ode_relative(mWork[i], mScale(i, mPredict[i])), 2);
+				}
+				const T norm = detail::sqrt(sum / T(n));
+				//Give up as soon as the rate of convergence says the iterations left won't be enough.
+				const T rate = k > 0 ? norm / previous : T(0);
+				if(k > 0 && (!(rate < 1) || detail::pow(rate, T(NEWTON_ITERATIONS - k)) / (1 - rate) * norm > tolerance))
+				{
+					return false;
+				}
+				for(std::size_t i = 0; i < n; ++i)
+				{
+					Traits::at(mPoint, i) += mWork[i];
+					mDelta[i] += mWork[i];
+				}
+				if(norm == 0 || (k > 0 && rate / (1 - rate) * norm < tolerance))
+				{
+					return true;
+				}
+				previous = norm;
+			}
+			return false;
+		}
+
+		bool mStepBDF(T end)
+		{
+			const std::size_t n = mN;
+			const T direction = end > mT ? 1 : -1;
+			const T left = detail::abs(end - mT);
+			const T smallest = 10 * detail::epsilon<T>() * std::max(detail::abs(mT), std::numeric_limits<T>::min());
+			if(mH == 0)
+			{
+				mH = detail::ode_initial_step(mF, mT, mY, mF0, mTemp, direction, left, 2, mOpts);
+				++mEvaluations;
+				for(std::size_t i = 0; i < n; ++i)
+				{
+					mD[i] = Traits::at(mY, i);
+					mD[n + i] = Traits::at(mF0, i) * mH * direction;
+				}
+			}
+			const T rtol = mOpts.rel_tol;
+			const T tolerance = rtol > 0 ? std::max(10 * detail::epsilon<T>() / rtol, std::min(T(0.03), detail::sqrt(rtol))) : T(0.03);
+
+			while(mH > smallest && mEvaluations + NEWTON_ITERATIONS <= mOpts.max_evaluations)
+			{
+				const bool last = mH >= left;
+				if(last && mH != left)
+				{
+					mRescale(left / mH);
+					mH = left;
+					mEqualSteps = 0;
+					mFactored = false;
+				}
+				const int order = mOrder;
+				const T h = direction * mH;
+				const T t = last ? end : mT + h;
+				//The prediction extrapolates the differences, and the correction solves
+				//h f(t, y) / alpha = y - prediction + psi for y = prediction + delta.
+				for(std::size_t i = 0; i < n; ++i)
+				{
+					T predict = 0;
+					T psi = 0;
+					for(int k = 0; k <= order; ++k)
+					{
+						predict += mD[k * n + i];
+						psi += k > 0 ? mD[k * n + i] * mGamma[k] : T(0);
+					}
+					mPredict[i] = predict;
+					mPsi[i] = psi / mAlpha[order];
+				}
+				const T c = h / mAlpha[order];
+
+				//Newton with the Jacobian and factors kept from before, and again with a fresh Jacobian if that didn't converge.
+				bool converged = false;
+				int iterations = 0;
+				while(true)
+				{
+					if(mJacobians > 0)
+					{
+						if(!mFactored)
+						{
+							++mFactorizations;
+							mFactored = mMatrix.factor(1, c);
+						}
+						converged = mFactored && mNewton(t, c, tolerance, iterations);
+						if(converged || mJacobianCurrent)
+						{
+							break;
+						}
+					}
+					if(mEvaluations + 1 + mJacobianCost() + NEWTON_ITERATIONS > mOpts.max_evaluations)
+					{
+						if(mJacobians == 0)
+						{
+							return false;
+						}
+						break;
+					}
+					for(std::size_t i = 0; i < n; ++i)
+					{
+						Traits::at(mPoint, i) = mPredict[i];
+					}
+					mStageF = mF(t, mPoint);
+					++mEvaluations;
+					mJacobian(t, mPoint, mStageF);
+					mFactored = false;
+				}
+				if(!converged)
+				{
+					mH /= 2;
+					mRescale(T(0.5));
+					mEqualSteps = 0;
+					mFactored = false;
+					++mRejected;
+					continue;
+				}
+
+				const T safety = T(0.9) * (2 * NEWTON_ITERATIONS + 1) / (2 * NEWTON_ITERATIONS + iterations);
+				auto normOf = [&](T constant, const T *difference){
+					T sum = 0;
+					for(std::size_t i = 0; i < n; ++i)
+					{
+						sum += detail::pow(detail::ode_relative(constant * difference[i], mScale(i, Traits::at(mPoint, i))), 2);
+					}
+					return detail::sqrt(sum / T(n));
+				};
+				const T norm = normOf(mErrorConst[order], mDelta.data());
+				if(!(norm <= 1))
+				{
+					//Keeps the factors, which are close enough to help Newton along: it did converge.
+					const T factor = detail::isfinite(norm) ? std::max(T(0.2), safety * detail::pow(norm, T(-1) / (order + 1))) : T(0.2);
+					mH *= factor;
+					mRescale(factor);
+					mEqualSteps = 0;
+					++mRejected;
+					continue;
+				}
+
+				for(std::size_t i = 0; i < n; ++i)
+				{
+					Traits::at(mError, i) += detail::abs(mErrorConst[order] * mDelta[i]);
+				}
+				mTOld = mT;
+				mT = t;
+				std::swap(mYOld, mY);
+				std::swap(mY, mPoint);
+				mJacobianCurrent = false;
+				++mSteps;
+				++mEqualSteps;
+				//D^(k+1) y_n = D^k y_n - D^k y_(n-1), where delta is D^(order+1) y_n.
+				for(std::size_t i = 0; i < n; ++i)
+				{
+					mD[(order + 2) * n + i] = mDelta[i] - mD[(order + 1) * n + i];
+					mD[(order + 1) * n + i] = mDelta[i];
+				}
+				for(int k = order; k >= 0; --k)
+				{
+					for(std::size_t i = 0; i < n; ++i)
+					{
+						mD[k * n + i] += mD[(k + 1) * n + i];
+					}
+				}
+
+				//After order+1 steps of one size, the order (one up or down, or the same) that allows the longest next step.
+				if(mEqualSteps >= order + 1)
+				{
+					mPoint = mY;
+					const T lower = order > 1 ? normOf(mErrorConst[order - 1], mD.data() + order * n) : detail::infinity<T>();
+					const T higher = order < MAX_ORDER ? normOf(mErrorConst[order + 1], mD.data() + (order + 2) * n) : detail::infinity<T>();
+					const T factors[3] = {detail::pow(lower, T(-1) / order), detail::pow(norm, T(-1) / (order + 1)),
+										  detail::pow(higher, T(-1) / (order + 2))};
+					const int best = int(std::max_element(factors, factors + 3) - factors);
+					mOrder = order + best - 1;
+					const T factor = std::min(T(10), safety * factors[best]);
+					mH *= factor;
+					mRescale(factor);
+					mEqualSteps = 0;
+					mFactored = false;
+				}
+				return true;
+			}
+			return false;
+		}
+	};
+
+	/**
+	 * @brief Solves a stiff y' = f(t, y) from t0 to t1.
+	 * 
+	 * @param f The right side. The state can be a scalar, a std::array or a std::vector.
+	 * @param t0 Where the solution starts.
+	 * @param y0 The solution there.
+	 * @param t1 Where to solve to. It may be before t0.
+	 * @param opts The method (see Stiff), tolerances and evaluation budget.
+	 * @param sparsity Which entries of the Jacobian can be nonzero, or empty for all of them.
+	 * @param jacobian Where the Jacobian comes from, such as ode_jacobian(), or nullptr for forward differences of f.
+	 * @return BasicEstimate<State> The solution at t1, with the sum of its steps' error estimates, component by component.
+	 * 		If it couldn't get there (see StiffStepper::step()), it's the solution where it stopped, with infinite errors.
+	 * 
+	 * @see StiffStepper
+	 * 
+	 */
+	template<typename State>
+	BasicEstimate<State> stiff_solve(NoDeduce<OdeFunc<State>> f, OdeScalar<State> t0, const State &y0, OdeScalar<State> t1,
+									 const BasicOptions<OdeScalar<State>> &opts = BasicOptions<OdeScalar<State>>(),
+									 const Sparsity &sparsity = Sparsity(), NoDeduce<OdeJacobian<State>> jacobian = nullptr)
+	{
+		StiffStepper<State> stepper(f, t0, y0, opts, sparsity, jacobian);
+		return detail::solve_to<State>(stepper, t1);
+	}
+
+	/**
+	 * @brief Solves a stiff y' = f(t, y) from t0, and interpolates the solution at a list of times.
+	 * 
+	 * @param f The right side. The state can be a scalar, a std::array or a std::vector.
+	 * @param t0 Where the solution starts.
+	 * @param y0 The solution there.
+	 * @param times Where to interpolate, in order away from t0 (either way).
+	 * @param opts The method (see Stiff), tolerances and evaluation budget.
+	 * @param sparsity Which entries of the Jacobian can be nonzero, or empty for all of them.
+	 * @param jacobian Where the Jacobian comes from, such as ode_jacobian(), or nullptr for forward differences of f.
+	 * @return std::vector<State> The solution at each time, NAN past wherever the solver had to stop.
+	 * 
+	 * @see StiffStepper::interpolate()
+	 * 
+	 */
+	template<typename State>
+	std::vector<State> stiff_solve_at(NoDeduce<OdeFunc<State>> f, OdeScalar<State> t0, const State &y0,
+									  const std::vector<OdeScalar<State>> &times,
+									  const BasicOptions<OdeScalar<State>> &opts = BasicOptions<OdeScalar<State>>(),
+									  const Sparsity &sparsity = Sparsity(), NoDeduce<OdeJacobian<State>> jacobian = nullptr)
+	{
+		if(times.empty())
+		{
+			return std::vector<State>();
+		}
+		StiffStepper<State> stepper(f, t0, y0, opts, sparsity, jacobian);
+		return detail::solve_at<State>(stepper, t0, y0, times);
+	}
+
+	//////////////////////////IMAGES/////////////////////////////
+
+	/**
+	 * @brief What images and graphs are written to: a file descriptor on POSIX systems, a C stream opened in binary mode elsewhere.
+	 * 
+	 */
+#if defined(CALC_POSIX)
+	typedef int FileHandle;
+#else
+	typedef std::FILE *FileHandle;
+#endif
+
+	namespace detail
+	{
+		/**
+		 * @brief CRC-32 (as in PNG and zlib) of some bytes, continuing from the CRC of the bytes before them.
+		 * 
+		 */
+		inline std::uint32_t crc32(const std::uint8_t *data, std::size_t size, std::uint32_t crc = 0)
+		{
+			static const std::array<std::uint32_t, 256> table = [](){
+				std::array<std::uint32_t, 256> t;
+				for(std::uint32_t n = 0; n < 256; ++n)
+				{
+					std::uint32_t c = n;
+					for(int k = 0; k < 8; ++k)
+					{
+						c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+					}
+					t[n] = c;
+				}
+				return t;
+			}();
+			crc = ~crc;
+			for(std::size_t i = 0; i < size; ++i)
+			{
+				crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+			}
+			return ~crc;
+		}
+
+		/**
+		 * @brief Adler-32 (as in zlib) of some bytes, continuing from the checksum of the bytes before them.
+		 * 
+		 */
+		inline std::uint32_t adler32(const std::uint8_t *data, std::size_t size, std::uint32_t adler = 1)
+		{
+			std::uint32_t a = adler & 0xFFFF;
+			std::uint32_t b = adler >> 16;
+			while(size > 0)
+			{
+				//The most bytes that can be summed before b could overflow.
+				std::size_t n = std::min<std::size_t>(size, 5552);
+				size -= n;
+				while(n-- > 0)
+				{
+					a += *data++;
+					b += a;
+				}
+				a %= 65521;
+				b %= 65521;
+			}
+			return (b << 16) | a;
+		}
+
+#if defined(CALC_POSIX)
+		typedef iovec WritePiece;
+#else
+		struct WritePiece
+		{
+			void *iov_base;
+			std::size_t iov_len;
+		};
+#endif
+
+		/**
+		 * @brief Writes a file from many pieces of memory with as few writev() calls as it can,
+		 * 		straight from wherever the pieces are. Without POSIX, it's an std::fwrite() a piece.
+		 * 
+		 * @remarks The pieces have to stay where they are until flush(), apart from the small ones given to copy().
+		 * 
+		 */
+		class FdWriter
+		{
+		public:
+			explicit FdWriter(FileHandle fd) : mFd(fd)
+			{
+			}
+
+			/**
+			 * @brief Queues a piece of memory.
+			 * 
+			 */
+			void add(const void *data, std::size_t size)
+			{
+				if(size == 0)
+				{
+					return;
+				}
+				if(mPieces.size() == 64)
+				{
+					flush();
+				}
+				WritePiece piece;
+				piece.iov_base = const_cast<void *>(data);
+				piece.iov_len = size;
+				mPieces.push_back(piece);
+			}
+
+			/**
+			 * @brief Queues a copy of up to 16 bytes, for headers that don't live anywhere else.
+			 * 
+			 */
+			void copy(const void *data, std::size_t size)
+			{
+				assert(size <= 16);
+				if(mPieces.size() == 64)
+				{
+					flush();
+				}
+				mCopies.emplace_back();
+				std::memcpy(mCopies.back().data(), data, size);
+				add(mCopies.back().data(), size);
+			}
+
+			/**
+			 * @brief Writes everything queued.
+			 * 
+			 */
+			void flush()
+			{
+#if defined(CALC_POSIX)
+				std::size_t first = 0;
+				while(first < mPieces.size())
+				{
+					ssize_t written = ::writev(mFd, mPieces.data() + first, int(mPieces.size() - first));
+					if(written < 0)
+					{
+						if(errno == EINTR)
+						{
+							continue;
+						}
+						throw std::runtime_error("FdWriter: couldn't write the file");
+					}
+					//Skip what was written, which may end in the middle of a piece.
+					std::size_t done = std::size_t(written);
+					while(first < mPieces.size() && done >= mPieces[first].iov_len)
+					{
+						done -= mPieces[first++].iov_len;
+					}
+					if(done > 0)
+					{
+						mPieces[first].iov_base = static_cast<char *>(mPieces[first].iov_base) + done;
+						mPieces[first].iov_len -= done;
+					}
+				}
+#else
+				for(const WritePiece &piece : mPieces)
+				{
+					if(std::fwrite(piece.iov_base, 1, piece.iov_len, mFd) != piece.iov_len)
+					{
+						throw std::runtime_error("FdWriter: couldn't write the file");
+					}
+				}
+				std::fflush(mFd);
+#endif
+				mPieces.clear();
+				mCopies.clear();
+			}
+		private:
+			FileHandle mFd;
+			std::vector<WritePiece> mPieces;
+			//Never moves what it holds, unlike a vector.
+			std::deque<std::array<std::uint8_t, 16>> mCopies;
+		};
+
+		/**
+		 * @brief A file opened for writing, closed when it goes out of scope.
+		 * 
+		 */
+		struct OutFile
+		{
+			FileHandle fd;
+
+			explicit OutFile(const std::string &path)
+			{
+#if defined(CALC_POSIX)
+				fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+				if(fd < 0)
+#else
+				fd = std::fopen(path.c_str(), "wb");
+				if(fd == nullptr)
+#endif
+				{
+					throw std::runtime_error("OutFile: couldn't open " + path);
+				}
+			}
+
+			~OutFile()
+			{
+#if defined(CALC_POSIX)
+				::close(fd);
+#else
+				std::fclose(fd);
+#endif
+			}
+
+			OutFile(const OutFile &) = delete;
+			OutFile &operator=(const OutFile &) = delete;
+		};
+
+		/**
+		 * @brief Whether a path ends in an extension, like ".png".
+		 * 
+		 */
+		inline bool has_extension(const std::string &path, const std::string &extension)
+		{
+			return path.size() >= extension.size()
+				   && std::equal(extension.rbegin(), extension.rend(), path.rbegin(), [](char a, char b){
+						  return std::tolower((unsigned char)a) == std::tolower((unsigned char)b);
+					  });
+		}
+
+		/**
+		 * @brief Clips a line to the rectangle from (0, 0) to (right, bottom), Liang-Barsky style.
+		 * 
+		 * @param u0 The column of the start, moved onto the edge if it's outside.
+		 * @param v0 The row of the start, likewise.
+		 * @param u1 The column of the end, likewise.
+		 * @param v1 The row of the end, likewise.
+		 * @param right The right edge.
+		 * @param bottom The bottom edge.
+		 * @return bool Whether any of the line is left.
+		 */
+		inline bool clip_line(double &u0, double &v0, double &u1, double &v1, double right, double bottom)
+		{
+			const double du = u1 - u0;
+			const double dv = v1 - v0;
+			//The line is (u0, v0) + t (du, dv); narrow t down to where it's inside each edge.
+			const double p[4] = {-du, du, -dv, dv};
+			const double q[4] = {u0, right - u0, v0, bottom - v0};
+			double enter = 0;
+			double leave = 1;
+			for(int i = 0; i < 4; ++i)
+			{
+				if(p[i] == 0)
+				{
+					//Parallel to this edge, so either all inside or all outside.
+					if(q[i] < 0)
+					{
+						return false;
+					}
+					continue;
+				}
+				double t = q[i] / p[i];
+				if(p[i] < 0)
+				{
+					enter = std::max(enter, t);
+				}
+				else
+				{
+					leave = std::min(leave, t);
+				}
+			}
+			if(enter > leave)
+			{
+				return false;
+			}
+			u1 = u0 + leave * du;
+			v1 = v0 + leave * dv;
+			u0 = u0 + enter * du;
+			v0 = v0 + enter * dv;
+			return true;
+		}
+		/**
+		 * @brief Which points of a polyline to keep so the rest are within a tolerance of it, Ramer-Douglas-Peucker style.
+		 * 
+		 * @param points The polyline, x & y interleaved.
+		 * @param tolerance How far a dropped point may be from the simplified line.
+		 * @return std::vector<bool> Whether to keep each point. The ends are always kept.
+		 */
+		inline std::vector<bool> decimate(const std::vector<double> &points, double tolerance)
+		{
+			const std::size_t count = points.size() / 2;
+			std::vector<bool> keep(count, false);
+			if(count == 0)
+			{
+				return keep;
+			}
+			keep.front() = keep.back() = true;
+			//Spans left to simplify, kept on a stack instead of recursing.
+			std::vector<std::pair<std::size_t, std::size_t>> spans;
+			spans.push_back(std::make_pair(std::size_t(0), count - 1));
+			while(!spans.empty())
+			{
+				std::size_t first = spans.back().first;
+				std::size_t last = spans.back().second;
+				spans.pop_back();
+				const double dx = points[2 * last] - points[2 * first];
+				const double dy = points[2 * last + 1] - points[2 * first + 1];
+				const double length = std::hypot(dx, dy);
+				double farthest = 0;
+				std::size_t index = first;
+				for(std::size_t i = first + 1; i < last; ++i)
+				{
+					const double px = points[2 * i] - points[2 * first];
+					const double py = points[2 * i + 1] - points[2 * first + 1];
+					//Distance to the line through the ends, or to the first end if they coincide.
+					double distance = length > 0 ? std::abs(dx * py - dy * px) / length : std::hypot(px, py);
+					if(distance > farthest)
+					{
+						farthest = distance;
+						index = i;
+					}
+				}
+				if(farthest > tolerance)
+				{
+					keep[index] = true;
+					spans.push_back(std::make_pair(first, index));
+					spans.push_back(std::make_pair(index, last));
+				}
+			}
+			return keep;
+		}
+	}
+
+	//////////////////////////UTILS/////////////////////////////
+	
+	/**
+	 * @brief A namespace of more utility & beauty functions than actual mathematical ones.
+	 * 
+	 */
+	namespace util
+	{
+		/**
+		 * @brief A color, for the functions in images.
+		 * 
+		 */
+		struct Color
+		{
+			std::uint8_t r;
+			std::uint8_t g;
+			std::uint8_t b;
+			std::uint8_t a;	//Opacity, 255 for opaque.
+		};
+
+		/**
+		 * @brief An RGBA image for Grapher to draw into, for when a terminal won't do.
+		 * 
+		 * @see Grapher::draw()
+		 * 
+		 */
+		class Raster
+		{
+		public:
+			/**
+			 * @brief Constructor.
+			 * 
+			 * @param width The width, in pixels.
+			 * @param height The height, in pixels.
+			 * @param background The color every pixel starts out as.
+			 */
+			Raster(int width, int height, Color background = Color{255, 255, 255, 255})
+			{
+				if(width < 1 || height < 1)
+				{
+					throw std::invalid_argument("Raster: width and height must be positive");
+				}
+				mWidth = width;
+				mHeight = height;
+				mPixels.resize(std::size_t(width) * height * 4);
+				fill(background);
+			}
+
+			int width() const
+			{
+				return mWidth;
+			}
+
+			int height() const
+			{
+				return mHeight;
+			}
+
+			/**
+			 * @brief The pixels, row by row from the top, as 4 bytes each: red, green, blue & opacity.
+			 * 
+			 */
+			const std::uint8_t *data() const
+			{
+				return mPixels.data();
+			}
+
+			/**
+			 * @brief Sets every pixel to a color.
+			 * 
+			 */
+			void fill(Color color)
+			{
+				for(std::size_t i = 0; i < mPixels.size(); i += 4)
+				{
+					mPixels[i] = color.r;
+					mPixels[i + 1] = color.g;
+					mPixels[i + 2] = color.b;
+					mPixels[i + 3] = color.a;
+				}
+			}
+
+			/**
+			 * @brief Paints a color over a pixel.
+			 * 
+			 * @param x The column of the pixel. Pixels off the image are ignored.
+			 * @param y The row of the pixel.
+			 * @param color The color.
+			 * @param coverage How much of the pixel the color covers, from 0 to 1.
+			 */
+			void blend(int x, int y, Color color, double coverage = 1)
+			{
+				if(x < 0 || x >= mWidth || y < 0 || y >= mHeight)
+				{
+					return;
+				}
+				const double alpha = color.a / 255.0 * std::min(std::max(coverage, 0.0), 1.0);
+				if(alpha <= 0)
+				{
+					return;
+				}
+				std::uint8_t *p = mPixels.data() + (std::size_t(y) * mWidth + x) * 4;
+				//Source over, with the colors not premultiplied by their opacity.
+				const double under = p[3] / 255.0 * (1 - alpha);
+				const double opacity = alpha + under;
+				const std::uint8_t source[3] = {color.r, color.g, color.b};
+				for(int c = 0; c < 3; ++c)
+				{
+					p[c] = std::uint8_t(std::lround((source[c] * alpha + p[c] * under) / opacity));
+				}
+				p[3] = std::uint8_t(std::lround(opacity * 255));
+			}
+
+			/**
+			 * @brief Draws an anti-aliased line, Xiaolin Wu style.
+			 * 
+			 * @param x0 The column of the start. Pixel centers are at whole numbers.
+			 * @param y0 The row of the start.
+			 * @param x1 The column of the end.
+			 * @param y1 The row of the end.
+			 * @param color The color.
+			 * 
+			 * @remarks The line is clipped to the image first, so the ends can be as far off it as they like.
+			 * 		A line from a point to itself is a dot.
+			 * 
+			 */
+			void line(double x0, double y0, double x1, double y1, Color color)
+			{
+				//Clip to a pixel past each edge, so lines leaving the image still fade out across the last pixel.
+				x0 += 1;
+				y0 += 1;
+				x1 += 1;
+				y1 += 1;
+				if(!detail::clip_line(x0, y0, x1, y1, mWidth + 1, mHeight + 1))
+				{
+					return;
+				}
+				x0 -= 1;
+				y0 -= 1;
+				x1 -= 1;
+				y1 -= 1;
+
+				//Step along whichever axis the line covers more of.
+				const bool steep = std::abs(y1 - y0) > std::abs(x1 - x0);
+				if(steep)
+				{
+					std::swap(x0, y0);
+					std::swap(x1, y1);
+				}
+				if(x0 > x1)
+				{
+					std::swap(x0, x1);
+					std::swap(y0, y1);
+				}
+				auto plot = [&](int x, int y, double coverage){
+					if(steep)
+					{
+						blend(y, x, color, coverage);
+					}
+					else
+					{
+						blend(x, y, color, coverage);
+					}
+				};
+				auto fpart = [](double v){
+					return v - std::floor(v);
+				};
+				const double gradient = (x1 == x0) ? (0) : ((y1 - y0) / (x1 - x0));
+
+				//The ends cover only the part of their pixels they reach into.
+				const int first = int(std::floor(x0 + 0.5));
+				double y = y0 + gradient * (first - x0);
+				double gap = 1 - fpart(x0 + 0.5);
+				plot(first, int(std::floor(y)), (1 - fpart(y)) * gap);
+				plot(first, int(std::floor(y)) + 1, fpart(y) * gap);
+				double intery = y + gradient;
+
+				const int last = int(std::floor(x1 + 0.5));
+				y = y1 + gradient * (last - x1);
+				gap = fpart(x1 + 0.5);
+				plot(last, int(std::floor(y)), (1 - fpart(y)) * gap);
+				plot(last, int(std::floor(y)) + 1, fpart(y) * gap);
+
+				//In between, every step splits its pixel between the two rows the line passes.
+				for(int x = first + 1; x < last; ++x)
+				{
+					plot(x, int(std::floor(intery)), 1 - fpart(intery));
+					plot(x, int(std::floor(intery)) + 1, fpart(intery));
+					intery += gradient;
+				}
+			}
+
+			/**
+			 * @brief Writes the image as a binary PPM.
+			 * 
+			 * @param fd The file to write to.
+			 * 
+			 * @remarks PPM has no opacity, so it's dropped. That takes a copy of the pixels, made a few rows at a time.
+			 * 
+			 */
+			void writePPM(FileHandle fd) const
+			{
+				detail::FdWriter out(fd);
+				char header[64];
+				int length = std::snprintf(header, sizeof(header), "P6\n%d %d\n255\n", mWidth, mHeight);
+				out.add(header, std::size_t(length));
+
+				const std::size_t rows = std::max<std::size_t>(1, 65536 / (std::size_t(mWidth) * 3));
+				std::vector<std::uint8_t> rgb(rows * mWidth * 3);
+				for(std::size_t row = 0; row < std::size_t(mHeight); row += rows)
+				{
+					const std::size_t count = std::min(rows, std::size_t(mHeight) - row) * mWidth;
+					const std::uint8_t *from = mPixels.data() + row * mWidth * 4;
+					for(std::size_t i = 0; i < count; ++i)
+					{
+						rgb[3 * i] = from[4 * i];
+						rgb[3 * i + 1] = from[4 * i + 1];
+						rgb[3 * i + 2] = from[4 * i + 2];
+					}
+					out.add(rgb.data(), count * 3);
+					out.flush();
+				}
+			}
+
+			/**
+			 * @brief Writes the image as an RGBA PNG.
+			 * 
+			 * @param fd The file to write to.
+			 * 
+			 * @remarks The pixels aren't compressed, just split into deflate's stored blocks, so nothing is needed but this header.
+			 * 		The rows are written straight from the image, with the block headers & checksums in between.
+			 * 
+			 */
+			void writePNG(FileHandle fd) const
+			{
+				const std::size_t stride = std::size_t(mWidth) * 4;
+				//Every row starts with its filter type, 0 for none.
+				const std::size_t raw = (stride + 1) * mHeight;
+				const std::size_t blocks = (raw + 65534) / 65535;
+				const std::size_t size = 2 + 5 * blocks + raw + 4;
+				if(size > 0x7FFFFFFF)
+				{
+					throw std::invalid_argument("Raster: too large for a PNG");
+				}
+				auto be32 = [](std::uint8_t *to, std::uint32_t value){
+					to[0] = std::uint8_t(value >> 24);
+					to[1] = std::uint8_t(value >> 16);
+					to[2] = std::uint8_t(value >> 8);
+					to[3] = std::uint8_t(value);
+				};
+				detail::FdWriter out(fd);
+
+				static const std::uint8_t signature[8] = {137, 'P', 'N', 'G', '\r', '\n', 26, '\n'};
+				out.add(signature, sizeof(signature));
+
+				//8 bits per channel, RGBA, no interlacing.
+				std::uint8_t ihdr[25] = {0, 0, 0, 13, 'I', 'H', 'D', 'R'};
+				be32(ihdr + 8, std::uint32_t(mWidth));
+				be32(ihdr + 12, std::uint32_t(mHeight));
+				ihdr[16] = 8;
+				ihdr[17] = 6;
+				be32(ihdr + 21, detail::crc32(ihdr + 4, 17));
+				out.add(ihdr, sizeof(ihdr));
+
+				//One IDAT chunk with a zlib stream in it, checksummed as it goes out.
+				std::uint8_t idat[10] = {0, 0, 0, 0, 'I', 'D', 'A', 'T', 0x78, 0x01};
+				be32(idat, std::uint32_t(size));
+				out.add(idat, sizeof(idat));
+				std::uint32_t crc = detail::crc32(idat + 4, 6);
+				std::uint32_t adler = 1;
+
+				static const std::uint8_t filter = 0;
+				std::size_t written = 0;
+				std::size_t blockLeft = 0;
+				auto put = [&](const std::uint8_t *data, std::size_t count){
+					while(count > 0)
+					{
+						if(blockLeft == 0)
+						{
+							blockLeft = std::min<std::size_t>(65535, raw - written);
+							const bool lastBlock = written + blockLeft == raw;
+							const std::uint8_t header[5] = {std::uint8_t(lastBlock), std::uint8_t(blockLeft), std::uint8_t(blockLeft >> 8),
+															std::uint8_t(~blockLeft), std::uint8_t(~blockLeft >> 8)};
+							out.copy(header, sizeof(header));
+							crc = detail::crc32(header, sizeof(header), crc);
+						}
+						const std::size_t take = std::min(count, blockLeft);
+						out.add(data, take);
+						crc = detail::crc32(data, take, crc);
+						adler = detail::adler32(data, take, adler);
+						data += take;
+						count -= take;
+						blockLeft -= take;
+						written += take;
+					}
+				};
+				for(int row = 0; row < mHeight; ++row)
+				{
+					put(&filter, 1);
+					put(mPixels.data() + row * stride, stride);
+				}
+
+				std::uint8_t tail[20] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 'I', 'E', 'N', 'D'};
+				be32(tail, adler);
+				crc = detail::crc32(tail, 4, crc);
+				be32(tail + 4, crc);
+				be32(tail + 16, detail::crc32(tail + 12, 4));
+				out.add(tail, sizeof(tail));
+				out.flush();
+			}
+
+			/**
+			 * @brief Writes the image to a file, as a PNG or PPM depending on the path's extension.
+			 * 
+			 * @param path Where to write, ending in .png or .ppm.
+			 */
+			void save(const std::string &path) const
+			{
+				const bool png = detail::has_extension(path, ".png");
+				if(!png && !detail::has_extension(path, ".ppm"))
+				{
+					throw std::invalid_argument("Raster: can only save .png and .ppm files, not " + path);
+				}
+				detail::OutFile file(path);
+				if(png)
+				{
+					writePNG(file.fd);
+				}
+				else
+				{
+					writePPM(file.fd);
+				}
+			}
+		private:
+			int mWidth;
+			int mHeight;
+			std::vector<std::uint8_t> mPixels;
+		};
+
+		/**
+		 * @brief Class to beautifully plot functions directly in terminal.
+		 * 
+		 * @remarks The grossest code you'll ever read. I'm sorry. It's late. I haven't had coffee.
+		 * 
+		 */
+		class Grapher
+		{
+		public:
+			/**
+			 * @brief How the graph is drawn into the terminal.
+			 * 
+			 */
+			enum class Mode
+			{
+				Ascii,		//One sample per character, drawn with the function's character.
+				HalfBlock,	//1x2 dots per character, drawn with Unicode half blocks.
+				Braille		//2x4 dots per character, drawn with Unicode Braille patterns.
+			};
+
+			/**
+			 * @brief Default Constructor.
+			 * 
+			 */
+			Grapher()
+			{
+				//Default values.
+				mTermWidth = 80;
+				mTermHeight = 24;
+				mXrange[0] = -10;
+				mXrange[1] = 10;
+				mYrange[0] = -10;
+				mYrange[1] = 10;
+				mMode = Mode::Ascii;
+				mThreads = 1;
+				mBudget = 0;
+				mFieldSpacing = 2;
+				mResize();
+			}
+
+			/**
+			 * @brief Set the dimensions, in characters, of the output graph.
+			 * 
+			 * @param width The width of the printed output.
+			 * @param height The height of the printed output.
+			 */
+			void setOutputDimensions(int width, int height)
+			{
+				if(width == mTermWidth && height == mTermHeight)
+				{
+					return;
+				}
+				mTermWidth = width;
+				mTermHeight = height;
+				mResize();
+			}
+
+			/**
+			 * @brief Set how the graph is drawn.
+			 * 
+			 * @param mode The drawing mode. The sub-character modes plot several dots per character
+			 * 		(in one color, ignoring the functions' characters) and need a terminal with UTF-8 & a font with the glyphs.
+			 */
+			void setMode(Mode mode)
+			{
+				if(mode == mMode)
+				{
+					return;
+				}
+				mMode = mode;
+				mResize();
+			}
+			
+			/**
+			 * @brief Set the domain of the function to render.
+			 * 
+			 * @param from The left end-point.
+			 * @param to The right end-point.
+			 */
+			void setDomain(double from, double to) 
+			{
+				mXrange[0] = from;
+				mXrange[1] = to;
+				mDirty = true;
+			}
+
+			/**
+			 * @brief Set the range of the function to render.
+			 * 
+			 * @param from The bottom-most point.
+			 * @param to The top-most point.
+			 */
+			void setRange(double from, double to)
+			{
+				mYrange[0] = from;
+				mYrange[1] = to;
+				mDirty = true;
+			}
+
+			/**
+			 * @brief Zooms the domain & range in or out around a point.
+			 * 
+			 * @param factor How many times closer to look, so 2 halves the domain & range and 0.5 doubles them.
+			 * @param x The x-coordinate that stays put.
+			 * @param y The y-coordinate that stays put.
+			 * 
+			 * @remarks The functions are sampled at the new scale, however small, not at the old one.
+			 * 
+			 */
+			void zoom(double factor, double x = 0, double y = 0)
+			{
+				for(int i = 0; i < 2; ++i)
+				{
+					mXrange[i] = x + (mXrange[i] - x) / factor;
+					mYrange[i] = y + (mYrange[i] - y) / factor;
+				}
+				mDirty = true;
+			}
+
+			/**
+			 * @brief Pushes another function to be rendered on display().
+			 * 
+			 * @param fx The function to render. Only called from several threads at once after setThreads().
+			 * @param funcChar The character to be used to draw the function.
+			 * @param color The color to draw the function in, in images.
+			 */
+			void addFunction(Func fx, char funcChar, Color color)
+			{
+				Plot plot = {fx, nullptr, 0, 0, funcChar, color, nullptr};
+				mPlots.push_back(plot);
+				mDirty = true;
+			}
+
+			/**
+			 * @brief Pushes another function to be rendered on display(), colored from a palette in images.
+			 * 
+			 * @param fx The function to render. Only called from several threads at once after setThreads().
+			 * @param funcChar The character to be used to draw the function.
+			 */
+			void addFunction(Func fx, char funcChar = '#')
+			{
+				addFunction(fx, funcChar, mNextColor());
+			}
+
+			/**
+			 * @brief Pushes a parametric curve, (x(t), y(t)), to be rendered on display().
+			 * 
+			 * @param x The x-coordinate at t. Like functions, x & y are only called from several threads at once after setThreads().
+			 * @param y The y-coordinate at t.
+			 * @param from The first t.
+			 * @param to The last t.
+			 * @param funcChar The character to be used to draw the curve.
+			 * @param color The color to draw the curve in, in images.
+			 * 
+			 * @remarks The curve is sampled by how far it moves on the screen, not evenly in t, so it's smooth
+			 * 		wherever it goes fast and cheap wherever it crawls.
+			 * 
+			 */
+			void addParametric(Func x, Func y, double from, double to, char funcChar, Color color)
+			{
+				Plot plot = {nullptr, [=](double t){
+					return std::make_pair(x(t), y(t));
+				}, from, to, funcChar, color, nullptr};
+				mPlots.push_back(plot);
+				mDirty = true;
+			}
+
+			/**
+			 * @brief Pushes a parametric curve, colored from a palette in images.
+			 * 
+			 * @see addParametric(Func, Func, double, double, char, Color)
+			 * 
+			 */
+			void addParametric(Func x, Func y, double from, double to, char funcChar = '#')
+			{
+				addParametric(x, y, from, to, funcChar, mNextColor());
+			}
+
+			/**
+			 * @brief Pushes a polar curve, r(theta), to be rendered on display().
+			 * 
+			 * @param r The distance from the origin at the angle theta. Negative distances point the other way.
+			 * @param from The first angle, in radians.
+			 * @param to The last angle.
+			 * @param funcChar The character to be used to draw the curve.
+			 * @param color The color to draw the curve in, in images.
+			 * 
+			 * @see addParametric()
+			 * 
+			 */
+			void addPolar(Func r, double from, double to, char funcChar, Color color)
+			{
+				Plot plot = {nullptr, [=](double theta){
+					double radius = r(theta);
+					return std::make_pair(radius * std::cos(theta), radius * std::sin(theta));
+				}, from, to, funcChar, color, nullptr};
+				mPlots.push_back(plot);
+				mDirty = true;
+			}
+
+			/**
+			 * @brief Pushes a polar curve, colored from a palette in images.
+			 * 
+			 * @see addPolar(Func, double, double, char, Color)
+			 * 
+			 */
+			void addPolar(Func r, double from, double to, char funcChar = '#')
+			{
+				addPolar(r, from, to, funcChar, mNextColor());
+			}
+
+			/**
+			 * @brief Pushes a trajectory of dy/dx = f(x, y), the solution through a point, to be rendered on display().
+			 * 
+			 * @param slope The right side, f(x, y). Like functions, only called from several threads at once after setThreads().
+			 * @param x0 The x-coordinate of the point.
+			 * @param y0 The y-coordinate of the point.
+			 * @param funcChar The character to be used to draw the trajectory.
+			 * @param color The color to draw the trajectory in, in images.
+			 * 
+			 * @remarks The solution is followed both ways from the point to the edges of the domain with OdeStepper, each step accurate
+			 * 		to a hundredth of a dot, and drawn from the interpolant every column. It stops early where it leaves the range by more than
+			 * 		the height of the screen, blows up, or runs out of the sample budget (see setSampleBudget()), at 6 evaluations a step.
+			 * 
+			 */
+			void addTrajectory(Func2 slope, double x0, double y0, char funcChar, Color color)
+			{
+				Plot plot = {nullptr, nullptr, x0, y0, funcChar, color, slope};
+				mPlots.push_back(plot);
+				mDirty = true;
+			}
+
+			/**
+			 * @brief Pushes a trajectory of dy/dx = f(x, y), colored from a palette in images.
+			 * 
+			 * @see addTrajectory(Func2, double, double, char, Color)
+			 * 
+			 */
+			void addTrajectory(Func2 slope, double x0, double y0, char funcChar = '*')
+			{
+				addTrajectory(slope, x0, y0, funcChar, mNextColor());
+			}
+
+			/**
+			 * @brief Draws the slope field of dy/dx = f(x, y) under the functions, as a short line through every point of a grid.
+			 * 
+			 * @param slope The right side, f(x, y). It's evaluated once per point, in parallel (see setThreads()).
+			 * @param spacing How many characters apart the points are across. They're half as many apart down,
+			 * 		since characters are about twice as tall as they're wide. In images, every 8 pixels count as a character, both ways.
+			 * 
+			 * @remarks In Ascii mode, each line is whichever of - / | \\ is closest to the slope as it looks on the screen.
+			 * 
+			 */
+			void setSlopeField(Func2 slope, int spacing = 2)
+			{
+				mField = slope;
+				mFieldSpacing = std::max(spacing, 1);
+				mDirty = true;
+			}
+
+			/**
+			 * @brief Stops drawing the slope field.
+			 * 
+			 */
+			void clearSlopeField()
+			{
+				mField = nullptr;
+				mDirty = true;
+			}
+
+			/**
+			 * @brief Resets all functions, curves and trajectories that were queued.
+			 * 
+			 */
+			void clearFunctions()
+			{
+				mPlots.clear();
+				mDirty = true;
+			}
+
+			/**
+			 * @brief Forces the next display() or refresh() to re-sample every function,
+			 * 		for when they depend on state the Grapher can't see change.
+			 * 
+			 */
+			void invalidate()
+			{
+				mDirty = true;
+			}
+
+			/**
+			 * @brief Set how many threads sample the functions.
+			 * 
+			 * @param threads The amount of threads, 0 for one per hardware thread, or 1 (the default) to call the functions
+			 * 		one after another on the calling thread.
+			 * 
+			 * @remarks With more than one thread, every added function is called concurrently with itself and the others,
+			 * 		so it must be safe to: no unguarded mutable captures, caches or memoized integrals.
+			 * 		Only the sampling is spread out; the graph is drawn from the samples in a fixed order,
+			 * 		so it comes out the same for any amount of threads.
+			 * 		The threads are started here and kept for every frame after, so animate() doesn't start new ones each frame.
+			 * 
+			 */
+			void setThreads(unsigned threads)
+			{
+				mThreads = threads;
+				mPool.reset();
+				if(threads != 1)
+				{
+					mPool = std::make_shared<detail::ThreadPool>(threads);
+				}
+			}
+
+			/**
+			 * @brief Caps how many times each function (or parametric curve) is evaluated per frame.
+			 * 
+			 * @param evaluations The most evaluations per function, or 0 for 4 per column of dots.
+			 * 
+			 * @remarks Functions are sampled on a grid of every 4th column, which is refined down to 1/16th of a column
+			 * 		wherever the curve bends or jumps by more than half a dot. Parametric curves start from 64 even steps of t instead,
+			 * 		refined down to 1/64th of a step. Past the cap, the grid is joined with straight lines.
+			 * 		Trajectories just stop where their cap runs out.
+			 * 
+			 */
+			void setSampleBudget(std::size_t evaluations)
+			{
+				mBudget = evaluations;
+				mDirty = true;
+			}
+
+			/**
+			 * @brief The main display call. Prints the final graph to the screen.
+			 * 
+			 * @remarks The graph is only re-drawn if something changed since the last call; otherwise the last frame is printed again.
+			 * 
+			 */
+			void display()
+			{
+				display(std::cout);
+			}
+
+			/**
+			 * @brief Prints the final graph to a stream, in a single write straight from the frame buffer.
+			 * 
+			 * @param out The stream.
+			 */
+			void display(std::ostream &out)
+			{
+				const char *data = frame();
+				out.write(data, std::streamsize(frameBytes()));
+				mPrinted = true;
+			}
+
+			/**
+			 * @brief Prints the final graph to a file, with write(2) straight from the frame buffer.
+			 * 
+			 * @param fd The file, like 1 (or stdout, without POSIX) for the standard output.
+			 * 		Anything buffered for it elsewhere, like std::cout, isn't flushed first.
+			 */
+			void display(FileHandle fd)
+			{
+				detail::FdWriter out(fd);
+				out.add(frame(), frameBytes());
+				out.flush();
+				mPrinted = true;
+			}
+
+			/**
+			 * @brief Draws the graph into a buffer of the caller's, exactly as display() would print it.
+			 * 
+			 * @param buffer Where to draw.
+			 * @param size The size of the buffer.
+			 * @return std::size_t The size of the graph. If it's more than size, nothing is written.
+			 */
+			std::size_t display(char *buffer, std::size_t size)
+			{
+				const char *data = frame();
+				if(frameBytes() <= size)
+				{
+					std::copy(data, data + frameBytes(), buffer);
+				}
+				return frameBytes();
+			}
+
+			/**
+			 * @brief The graph, exactly as display() would print it, without copying it anywhere.
+			 * 
+			 * @return const char* The frame buffer, frameBytes() long, newlines and all.
+			 * 		It's good until the Grapher is next drawn, resized or changes mode.
+			 */
+			const char *frame()
+			{
+				mRender();
+				//Whoever shows a new frame shows all of it, so there's nothing left to refresh(), and the terminal may be behind.
+				if(!mChanges.empty())
+				{
+					mChanges.clear();
+					mPrinted = false;
+				}
+				return mShown.data();
+			}
+
+			/**
+			 * @brief The size of the graph as printed, in bytes.
+			 * 
+			 */
+			std::size_t frameBytes() const
+			{
+				return mShown.size();
+			}
+
+			/**
+			 * @brief Re-prints only the characters that changed, over the graph display() or refresh() printed last.
+			 * 
+			 * @remarks Uses ANSI escapes to move the cursor, so the last frame has to be directly above the cursor,
+			 * 		with nothing printed after it. Falls back to display() if there's no such frame.
+			 * 
+			 */
+			void refresh()
+			{
+				refresh(std::cout);
+			}
+
+			/**
+			 * @brief Re-prints only the characters that changed to a stream, straight from the frame buffer.
+			 * 
+			 * @param out The stream, which has to be the one the last frame was printed to.
+			 * 
+			 * @see refresh()
+			 * 
+			 */
+			void refresh(std::ostream &out)
+			{
+				if(!mPrinted)
+				{
+					display(out);
+					return;
+				}
+				mRender();
+				if(mChanges.empty())
+				{
+					return;
+				}
+
+				//Up to the top row of the last frame, then to the start of every run of changed characters in turn.
+				char move[32];
+				out.write(move, std::snprintf(move, sizeof(move), "\x1b[%dA", mTermHeight));
+				int row = 0;
+				for(const auto &run : mChanges)
+				{
+					const int r = int(run.first / mTermWidth);
+					const int c = int(run.first % mTermWidth);
+					out.put('\r');
+					//A move of 0 is taken as 1, so leave those out.
+					if(r > row)
+					{
+						out.write(move, std::snprintf(move, sizeof(move), "\x1b[%dB", r - row));
+						row = r;
+					}
+					if(c > 0)
+					{
+						out.write(move, std::snprintf(move, sizeof(move), "\x1b[%dC", c));
+					}
+					out.write(mShown.data() + mCell(run.first), std::streamsize((run.second - run.first) * mCellBytes()));
+				}
+				//And back below the frame.
+				out.write(move, std::snprintf(move, sizeof(move), "\r\x1b[%dB", mTermHeight - row));
+				out.flush();
+				mChanges.clear();
+			}
+
+			/**
+			 * @brief How long the frames of an animation took.
+			 * 
+			 * @see animate()
+			 * 
+			 */
+			struct FrameTimes
+			{
+				/**
+				 * @brief Frames by how long they took: bin i counts those that took from i to i+1 milliseconds, the last bin any longer.
+				 * 
+				 */
+				std::array<std::size_t, 64> histogram{};
+
+				/**
+				 * @brief How many frames were played.
+				 * 
+				 */
+				std::size_t frames = 0;
+
+				/**
+				 * @brief How many frames took longer than the frame budget.
+				 * 
+				 */
+				std::size_t late = 0;
+
+				/**
+				 * @brief The longest and average frame, in milliseconds.
+				 * 
+				 */
+				double longest = 0;
+				double average = 0;
+
+				/**
+				 * @brief A percentile of the frame times, to the millisecond.
+				 * 
+				 * @param p The percentile, from 0 to 100.
+				 * @return double The time, in milliseconds, that p percent of the frames took at most. Rounded up to the end of its bin.
+				 */
+				double percentile(double p) const
+				{
+					const double rank = p / 100 * frames;
+					std::size_t seen = 0;
+					for(std::size_t i = 0; i < histogram.size(); ++i)
+					{
+						seen += histogram[i];
+						if(seen > 0 && seen >= rank)
+						{
+							return i + 1 < histogram.size() ? double(i + 1) : longest;
+						}
+					}
+					return longest;
+				}
+			};
+
+			/**
+			 * @brief Plays an animation in place, re-printing only the characters that changed from frame to frame.
+			 * 
+			 * @param frames How many frames to play.
+			 * @param update Called before every frame with its number, to change the functions or the view for it.
+			 * @param fps The frame rate to keep to. Each frame has 1/fps seconds to update, draw & print, and the rest is slept off.
+			 * @param out The stream to play it on.
+			 * @return FrameTimes How long each frame took, not counting the sleep.
+			 * 
+			 * @remarks A late frame isn't made up for by rushing the next ones; the schedule starts over from it.
+			 * 		The cursor is hidden while playing. Like refresh(), it starts from the frame display() printed last, if any.
+			 * 
+			 */
+			FrameTimes animate(std::size_t frames, std::function<void(std::size_t)> update, double fps = 30, std::ostream &out = std::cout)
+			{
+				typedef std::chrono::steady_clock Clock;
+				const auto budget = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1 / fps));
+				FrameTimes times;
+				out << "\x1b[?25l";
+				auto next = Clock::now();
+				for(std::size_t i = 0; i < frames; ++i)
+				{
+					const auto start = Clock::now();
+					update(i);
+					//The functions may depend on whatever update changed.
+					mDirty = true;
+					refresh(out);
+					const auto end = Clock::now();
+
+					const double took = std::chrono::duration<double, std::milli>(end - start).count();
+					++times.histogram[std::min(std::size_t(took), times.histogram.size() - 1)];
+					++times.frames;
+					times.late += (end - start) > budget;
+					times.longest = std::max(times.longest, took);
+					times.average += (took - times.average) / times.frames;
+
+					next += budget;
+					if(next < end)
+					{
+						next = end;
+					}
+					else
+					{
+						std::this_thread::sleep_until(next);
+					}
+				}
+				out << "\x1b[?25h" << std::flush;
+				return times;
+			}
+
+			/**
+			 * @brief Draws the graph into an image, anti-aliased, with each function in its color.
+			 * 
+			 * @param image The image to draw over. The functions are sampled at its resolution.
+			 */
+			void draw(Raster &image)
+			{
+				const int width = image.width();
+				//Pixel centers are at whole numbers, so the range spans rows height-1 to 0 here.
+				const int height = image.height() - 1;
+				mSampleCurves(width, height);
+
+				const Color axis = {160, 160, 160, 255};
+				const double xaxis = mYToRow(0, height);
+				const double yaxis = mXToColumn(0, width);
+				image.line(yaxis, 0, yaxis, height, axis);
+				image.line(0, xaxis, width - 1, xaxis, axis);
+				const Color field = {200, 200, 200, 255};
+				const double spacing = 8.0 * mFieldSpacing;
+				mTraceField(width, height, spacing, spacing, [&](double u, double v, double du, double dv){
+					const double reach = 0.4 * spacing;
+					image.line(u - du * reach, v - dv * reach, u + du * reach, v + dv * reach, field);
+				});
+				for(std::size_t p = 0; p < mPlots.size(); ++p)
+				{
+					mTrace(mCurves[p], [&](double u0, double v0, double u1, double v1){
+						image.line(u0, v0, u1, v1, mPlots[p].color);
+					});
+				}
+			}
+
+			/**
+			 * @brief Writes the graph as an SVG, with each function as polylines in its color.
+			 * 
+			 * @param fd The file to write to.
+			 * @param width The width of the image.
+			 * @param height The height of the image.
+			 * 
+			 * @remarks The curves are clipped to the image, and each polyline is decimated to within a quarter of a unit.
+			 * 
+			 */
+			void writeSVG(FileHandle fd, int width, int height)
+			{
+				mSampleCurves(width, height);
+				detail::FdWriter out(fd);
+				std::string text;
+				char buffer[256];
+				auto print = [&](int length){
+					text.append(buffer, std::size_t(length));
+					if(text.size() >= 65536)
+					{
+						out.add(text.data(), text.size());
+						out.flush();
+						text.clear();
+					}
+				};
+
+				print(std::snprintf(buffer, sizeof(buffer),
+					"<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"%d\" height=\"%d\" viewBox=\"0 0 %d %d\">\n"
+					"<rect width=\"100%%\" height=\"100%%\" fill=\"white\"/>\n", width, height, width, height));
+				const double xaxis = mYToRow(0, height);
+				const double yaxis = mXToColumn(0, width);
+				if(xaxis >= 0 && xaxis <= height)
+				{
+					print(std::snprintf(buffer, sizeof(buffer), "<line x1=\"0\" y1=\"%.2f\" x2=\"%d\" y2=\"%.2f\" stroke=\"#a0a0a0\"/>\n",
+										xaxis, width - 1, xaxis));
+				}
+				if(yaxis >= 0 && yaxis <= width - 1)
+				{
+					print(std::snprintf(buffer, sizeof(buffer), "<line x1=\"%.2f\" y1=\"0\" x2=\"%.2f\" y2=\"%d\" stroke=\"#a0a0a0\"/>\n",
+										yaxis, yaxis, height));
+				}
+				const double spacing = 8.0 * mFieldSpacing;
+				bool field = false;
+				mTraceField(width, height, spacing, spacing, [&](double u, double v, double du, double dv){
+					if(!field)
+					{
+						print(std::snprintf(buffer, sizeof(buffer), "<path fill=\"none\" stroke=\"#c8c8c8\" d=\""));
+						field = true;
+					}
+					const double reach = 0.4 * spacing;
+					print(std::snprintf(buffer, sizeof(buffer), "M%.2f,%.2fL%.2f,%.2f", u - du * reach, v - dv * reach, u + du * reach, v + dv * reach));
+				});
+				if(field)
+				{
+					print(std::snprintf(buffer, sizeof(buffer), "\"/>\n"));
+				}
+
+				std::vector<double> run;
+				for(std::size_t p = 0; p < mPlots.size(); ++p)
+				{
+					const Color &color = mPlots[p].color;
+					auto end = [&](){
+						if(run.size() >= 4)
+						{
+							print(std::snprintf(buffer, sizeof(buffer), "<polyline fill=\"none\" stroke=\"#%02x%02x%02x\" stroke-opacity=\"%.3f\" points=\"",
+												color.r, color.g, color.b, color.a / 255.0));
+							std::vector<bool> keep = detail::decimate(run, 0.25);
+							for(std::size_t i = 0; i < keep.size(); ++i)
+							{
+								if(keep[i])
+								{
+									print(std::snprintf(buffer, sizeof(buffer), "%.2f,%.2f ", run[2 * i], run[2 * i + 1]));
+								}
+							}
+							print(std::snprintf(buffer, sizeof(buffer), "\"/>\n"));
+						}
+						run.clear();
+					};
+					mTrace(mCurves[p], [&](double u0, double v0, double u1, double v1){
+						const double from[2] = {u0, v0};
+						const double to[2] = {u1, v1};
+						if(!detail::clip_line(u0, v0, u1, v1, width - 1, height))
+						{
+							end();
+							return;
+						}
+						//Lines that don't carry on from the last one start a new polyline.
+						if(run.empty() || u0 != from[0] || v0 != from[1] || run[run.size() - 2] != u0 || run.back() != v0)
+						{
+							end();
+							run.push_back(u0);
+							run.push_back(v0);
+						}
+						run.push_back(u1);
+						run.push_back(v1);
+						if(u1 != to[0] || v1 != to[1])
+						{
+							end();
+						}
+					});
+					end();
+				}
+				print(std::snprintf(buffer, sizeof(buffer), "</svg>\n"));
+				out.add(text.data(), text.size());
+				out.flush();
+			}
+
+			/**
+			 * @brief Writes the graph to an image file, picking the format from the path's extension.
+			 * 
+			 * @param path Where to write, ending in .png, .ppm or .svg.
+			 * @param width The width of the image, in pixels.
+			 * @param height The height of the image, in pixels.
+			 */
+			void save(const std::string &path, int width, int height)
+			{
+				if(detail::has_extension(path, ".svg"))
+				{
+					detail::OutFile file(path);
+					writeSVG(file.fd, width, height);
+					return;
+				}
+				Raster image(width, height);
+				draw(image);
+				image.save(path);
+			}
+		private:
+			/**
+			 * @brief Something to render: the graph of a function, a parametric curve, or a trajectory.
+			 * 
+			 */
+			struct Plot
+			{
+				Func fx;	//The function, for graphs.
+				std::function<std::pair<double, double>(double)> point;	//The point at t, for parametric curves.
+				double from;	//The range of t, for parametric curves, and the point the solution goes through, for trajectories.
+				double to;
+				char character;
+				Color color;
+				Func2 slope;	//The right side of the equation, for trajectories.
+			};
+			std::vector<Plot> mPlots;
+			int mTermWidth;
+			int mTermHeight;
+			double mXrange[2];
+			double mYrange[2];
+
+			Mode mMode;
+			/*
+			The frame buffers, mTermHeight rows of mTermWidth characters and a newline back to back, UTF-8 encoded in the sub-character modes,
+			so they can be printed as they are.
+			Frames are drawn into mScreen, then swapped into mShown to be printed, so the last frame is always there to diff against.
+			*/
+			std::vector<char> mScreen;
+			std::vector<char> mShown;
+			//The sub-character modes' dots, one byte of bits per character.
+			std::vector<std::uint8_t> mDots;
+			//Runs of characters that changed in the last frame drawn, as [first, last) indices of characters in the frame.
+			std::vector<std::pair<std::size_t, std::size_t>> mChanges;
+			//Whether mShown is on the terminal, right above the cursor.
+			bool mPrinted;
+			//Whether any setting changed since the frame buffer was last drawn.
+			bool mDirty;
+			unsigned mThreads;
+			//The threads that sample, when there's more than one. Copies of the Grapher share them.
+			std::shared_ptr<detail::ThreadPool> mPool;
+
+			/**
+			 * @brief A point on a function's curve, in dots.
+			 * 
+			 */
+			struct Sample
+			{
+				double t;	//Where the curve was sampled: the column for graphs, t for parametric curves.
+				double u;	//The column, in between columns where the curve was refined.
+				double v;	//The row, NAN where the function isn't defined.
+				bool jump;	//Whether the curve breaks between this sample and the next.
+			};
+			//Every plot's curve, plot by plot.
+			std::vector<std::vector<Sample>> mCurves;
+			//Most evaluations per plot per frame, 0 for the default.
+			std::size_t mBudget;
+			//The slope field, if any, and how many characters apart its points are.
+			Func2 mField;
+			int mFieldSpacing;
+			/*
+			The grid refinement starts from, every mGridStep-th column for graphs and mGridIntervals even steps of t for parametric curves,
+			and how many times its intervals may be halved.
+			*/
+			static const int mGridStep = 4;
+			static const int mGridIntervals = 64;
+			static const int mRefineDepth = 6;
+
+			//Every character of the sub-character modes is 3 bytes of UTF-8, blanks included, so the rows stay the same length.
+			std::size_t mCellBytes() const
+			{
+				return mMode == Mode::Ascii ? 1 : 3;
+			}
+
+			//The bytes of a row, not counting its newline.
+			std::size_t mRowBytes() const
+			{
+				return std::size_t(mTermWidth) * mCellBytes();
+			}
+
+			char *mRow(int row)
+			{
+				return mScreen.data() + std::size_t(row) * (mRowBytes() + 1);
+			}
+
+			//Where a character, counting row by row, starts in the frame buffers.
+			std::size_t mCell(std::size_t index) const
+			{
+				return (index / mTermWidth) * (mRowBytes() + 1) + (index % mTermWidth) * mCellBytes();
+			}
+
+			void mResize()
+			{
+				//The only place the frame buffer is ever reallocated.
+				mScreen.assign((mRowBytes() + 1) * mTermHeight, ' ');
+				for(int i = 0; i < mTermHeight; ++i)
+				{
+					mRow(i)[mRowBytes()] = '\n';
+				}
+				mShown = mScreen;
+				mDots.assign(std::size_t(mTermWidth) * mTermHeight, 0);
+				mChanges.clear();
+				mPrinted = false;
+				mDirty = true;
+			}
+
+			/**
+			 * @brief The bit of a character's dot byte that holds one of its dots.
+			 * 
+			 * @param x The dot's column within the character.
+			 * @param y The dot's row within the character.
+			 * @return std::uint8_t The bit. For Braille, it's the bit of that dot in the Unicode pattern.
+			 */
+			std::uint8_t mDotBit(int x, int y) const
+			{
+				static const std::uint8_t braille[2][4] = {{0x01, 0x02, 0x04, 0x40}, {0x08, 0x10, 0x20, 0x80}};
+				return mMode == Mode::Braille ? braille[x][y] : std::uint8_t(1 << y);
+			}
+
+			/**
+			 * @brief Writes the glyph for a character's dots into the frame buffer.
+			 * 
+			 * @param out Where the character's 3 bytes go.
+			 * @param dots The character's dot byte.
+			 */
+			void mEncode(char *out, std::uint8_t dots) const
+			{
+				//U+2800 + the dots is the Braille pattern with those dots, and U+2800 is also the blank for both modes.
+				unsigned code = 0x2800 + dots;
+				if(mMode == Mode::HalfBlock && dots != 0)
+				{
+					//Upper half, lower half, full block.
+					static const unsigned blocks[3] = {0x2580, 0x2584, 0x2588};
+					code = blocks[dots - 1];
+				}
+				out[0] = char(0xE0 | (code >> 12));
+				out[1] = char(0x80 | ((code >> 6) & 0x3F));
+				out[2] = char(0x80 | (code & 0x3F));
+			}
 
-	/**
-	 * @brief Iterate a function over a value an amount of times.
-	 * 
-	 * @param fx The function to iterate. 
-	 * @param times The amount of times to iterate.
-	 * @param value The value to iterate over.
-	 * @return double The result.
-	 */
-	double iterate(Func fx, double times, double value)
-	{
-		if(times <= 0)
-		{
-			return value;
-		}
-		else return fx(iterate(fx, times-1, value));
-	}
+			/**
+			 * @brief The color of the next plot, from a palette.
+			 * 
+			 */
+			Color mNextColor() const
+			{
+				static const Color palette[8] = {
+					{31, 119, 180, 255}, {255, 127, 14, 255}, {44, 160, 44, 255}, {214, 39, 40, 255},
+					{148, 103, 189, 255}, {140, 86, 75, 255}, {227, 119, 194, 255}, {23, 190, 207, 255}
+				};
+				return palette[mPlots.size() % 8];
+			}
 
-	/**
-	 * @brief Like iterate(), except generalized by returning a lambda for all values.
-	 * 
-	 * @param fx The function to iterate.
-	 * @param times The amount of times to iterate.
-	 * @return Func A lambda composed of the iterated function.
-	 * 
-	 * @see iterate()
-	 */
-	Func iterated(Func fx, double times)
-	{
-		return [=](double x)->double{
-			return iterate(fx, times, x);
-		};
-	}
+			/**
+			 * @brief Samples a plot.
+			 * 
+			 * @param plot The plot.
+			 * @param t The column to sample a graph at, which doesn't have to be whole, or the t to sample a parametric curve at.
+			 * @param width The width of the graph, in dots.
+			 * @param height The height of the graph, in dots.
+			 * @return Sample The point on the curve.
+			 */
+			Sample mSample(const Plot &plot, double t, int width, int height) const
+			{
+				Sample s = {t, t, NAN, false};
+				if(plot.fx)
+				{
+					double y = plot.fx(mColumnToX(t, width));
+					s.v = std::isfinite(y) ? mYToRow(y, height) : NAN;
+					return s;
+				}
+				std::pair<double, double> point = plot.point(t);
+				if(std::isfinite(point.first) && std::isfinite(point.second))
+				{
+					s.u = mXToColumn(point.first, width);
+					s.v = mYToRow(point.second, height);
+				}
+				return s;
+			}
 
-	/**
-	 * @brief Returns the first solution to setting left & right equal to eachother.
-	 * 
-	 * @param left Left side of the equal sign.
-	 * @param right Right side of the equal sign.
-	 * @return double The first found solution.
-	 */
-	double solve(Func left, Func right)
-	{
-		return roots([&](double x)->double{
-			return left(x)-right(x);
-		});
-	}
+			/**
+			 * @brief Adds samples in between two samples of a plot, wherever a straight line between them wouldn't do.
+			 * 
+			 * @param plot The plot.
+			 * @param a The first sample, which has to be the last one in out.
+			 * @param b The second sample, which isn't added.
+			 * @param depth How many more times the interval may be halved.
+			 * @param budget Evaluations left, shared with the rest of the block of the grid.
+			 * @param out Where the samples go.
+			 * @param width The width of the graph, in dots.
+			 * @param height The height of the graph, in dots.
+			 * 
+			 * @remarks An interval is halved while its middle is more than half a dot off the middle of the line between its ends,
+			 * 		unless all of it is off the same side of the screen. For a graph, that's how far the curve bends;
+			 * 		for a parametric curve, it's also how unevenly it moves, so it gets sampled by arc length on the screen.
+			 * 		A continuous curve splits its length about evenly between the halves, so if one half of the last interval
+			 * 		still holds most of a jump over 2 dots, it's a discontinuity or a pole, and the curve is broken there.
+			 * 
+			 */
+			void mRefine(const Plot &plot, const Sample &a, const Sample &b, int depth, std::size_t &budget,
+						 std::vector<Sample> &out, int width, int height) const
+			{
+				if(depth <= 0 || budget == 0)
+				{
+					return;
+				}
+				--budget;
+				Sample m = mSample(plot, (a.t + b.t) / 2, width, height);
+				const int defined = std::isfinite(a.v) + std::isfinite(m.v) + std::isfinite(b.v);
+				if(defined == 3)
+				{
+					const bool offscreen = (a.v < 0 && m.v < 0 && b.v < 0) || (a.v > height && m.v > height && b.v > height)
+										|| (a.u < 0 && m.u < 0 && b.u < 0) || (a.u > width - 1 && m.u > width - 1 && b.u > width - 1);
+					const bool straight = std::hypot(m.u - (a.u + b.u) / 2, m.v - (a.v + b.v) / 2) <= 0.5;
+					if(offscreen || straight)
+					{
+						out.push_back(m);
+						return;
+					}
+				}
+				//Nothing to draw where the function isn't defined at all. Where it's partly defined, keep halving to find the edge.
+				else if(defined == 0)
+				{
+					out.push_back(m);
+					return;
+				}
+
+				if(depth > 1)
+				{
+					mRefine(plot, a, m, depth - 1, budget, out, width, height);
+					out.push_back(m);
+					mRefine(plot, m, b, depth - 1, budget, out, width, height);
+					return;
+				}
+				const double rise = std::hypot(b.u - a.u, b.v - a.v);
+				const double left = std::hypot(m.u - a.u, m.v - a.v);
+				const double right = std::hypot(b.u - m.u, b.v - m.v);
+				if(defined == 3 && rise > 2 && std::max(left, right) > 0.75 * rise)
+				{
+					if(left > right)
+					{
+						out.back().jump = true;
+					}
+					else
+					{
+						m.jump = true;
+					}
+				}
+				out.push_back(m);
+			}
 
-	//////////////////////////UTILS/////////////////////////////
-	
-	/**
-	 * @brief A namespace of more utility & beauty functions than actual mathematical ones.
-	 * 
-	 */
-	namespace util
-	{
-		/**
-		 * @brief Class to beautifully plot functions directly in terminal.
-		 * 
-		 * @remarks The grossest code you'll ever read. I'm sorry. It's late. I haven't had coffee.
-		 * 
-		 */
-		class Grapher
-		{
-		public:
 			/**
-			 * @brief Default Constructor.
+			 * @brief How many intervals the grid of a plot has.
 			 * 
 			 */
-			Grapher()
+			std::size_t mGridSize(const Plot &plot, int width) const
 			{
-				//Default values.
-				mTermWidth = 80;
-				mTermHeight = 24;
-				mXrange[0] = -10;
-				mXrange[1] = 10;
-				mYrange[0] = -10;
-				mYrange[1] = 10;
+				return plot.fx ? std::max<std::size_t>(1, (width + mGridStep - 2) / mGridStep) : std::size_t(mGridIntervals);
 			}
 
 			/**
-			 * @brief Set the dimensions, in characters, of the output graph.
+			 * @brief Where a point of the grid of a plot is, as passed to mSample().
 			 * 
-			 * @param width The width of the printed output.
-			 * @param height The height of the printed output.
 			 */
-			void setOutputDimensions(int width, int height)
+			double mGridPoint(const Plot &plot, std::size_t i, int width) const
 			{
-				mTermWidth = width;
-				mTermHeight = height;
+				if(plot.fx)
+				{
+					return std::min(double(i) * mGridStep, double(width - 1));
+				}
+				return plot.from + (plot.to - plot.from) * double(i) / mGridIntervals;
 			}
-			
+
 			/**
-			 * @brief Set the domain of the function to render.
+			 * @brief Samples every plot into mCurves, for a graph of a given size.
 			 * 
-			 * @param from The left end-point.
-			 * @param to The right end-point.
+			 * @param width The width of the graph, in dots.
+			 * @param height The height of the graph, in dots.
 			 */
-			void setDomain(double from, double to) 
+			void mSampleCurves(int width, int height)
 			{
-				mXrange[0] = from;
-				mXrange[1] = to;
+				//Sample every plot up front, spread over the threads in blocks of its grid (16 columns, for graphs).
+				//Each block refines its part of the grid on its own, so the curves come out the same for any amount of threads.
+				const std::size_t block = 4;
+				const std::size_t budget = mBudget > 0 ? mBudget : std::size_t(4) * width;
+				std::vector<std::size_t> firstTask(mPlots.size() + 1, 0);
+				for(std::size_t p = 0; p < mPlots.size(); ++p)
+				{
+					//A trajectory is solved in one go.
+					firstTask[p + 1] = firstTask[p] + (mPlots[p].slope ? 1 : (mGridSize(mPlots[p], width) + block - 1) / block);
+				}
+				std::vector<std::vector<Sample>> pieces(firstTask.back());
+				detail::parallel_for(pieces.size(), mThreads, [&](std::size_t task){
+					const std::size_t p = std::upper_bound(firstTask.begin(), firstTask.end(), task) - firstTask.begin() - 1;
+					const Plot &plot = mPlots[p];
+					if(plot.slope)
+					{
+						mSolve(plot, budget, pieces[task], width, height);
+						return;
+					}
+					const std::size_t grid = mGridSize(plot, width);
+					const std::size_t first = (task - firstTask[p]) * block;
+					const std::size_t last = std::min(first + block, grid);
+					//This block's share of the budget, on top of the grid itself.
+					std::size_t left = budget * (last - first) / grid;
+					std::vector<Sample> &out = pieces[task];
+					Sample a = mSample(plot, mGridPoint(plot, first, width), width, height);
+					out.push_back(a);
+					for(std::size_t i = first + 1; i <= last; ++i)
+					{
+						Sample b = mSample(plot, mGridPoint(plot, i, width), width, height);
+						mRefine(plot, a, b, mRefineDepth, left, out, width, height);
+						//The first sample of the next block ends this one.
+						if(i != last || last == grid)
+						{
+							out.push_back(b);
+						}
+						a = b;
+					}
+				}, mPool.get());
+				mCurves.assign(mPlots.size(), std::vector<Sample>());
+				for(std::size_t p = 0; p < mPlots.size(); ++p)
+				{
+					for(std::size_t task = firstTask[p]; task < firstTask[p + 1]; ++task)
+					{
+						mCurves[p].insert(mCurves[p].end(), pieces[task].begin(), pieces[task].end());
+					}
+				}
 			}
 
 			/**
-			 * @brief Set the range of the function to render.
+			 * @brief Solves a trajectory into samples, both ways from its point.
 			 * 
-			 * @param from The bottom-most point.
-			 * @param to The top-most point.
+			 * @param plot The trajectory.
+			 * @param budget The most evaluations of its equation.
+			 * @param out Where the samples go, left to right.
+			 * @param width The width of the graph, in dots.
+			 * @param height The height of the graph, in dots.
 			 */
-			void setRange(double from, double to)
+			void mSolve(const Plot &plot, std::size_t budget, std::vector<Sample> &out, int width, int height) const
 			{
-				mYrange[0] = from;
-				mYrange[1] = to;
+				const double column = std::abs(mXrange[1] - mXrange[0]) / std::max(width - 1, 1);
+				Options opts;
+				opts.rel_tol = 0;
+				opts.abs_tol = 0.01 * std::abs(mYrange[1] - mYrange[0]) / height;
+				//Steps as long as the accuracy allows, sampled every column in between.
+				auto solve = [&](double to, std::size_t evaluations, std::vector<Sample> &samples){
+					opts.max_evaluations = evaluations;
+					OdeStepper<double> stepper(plot.slope, plot.from, plot.to, opts);
+					const double step = to < plot.from ? -column : column;
+					auto visit = [&](double x, double y){
+						const Sample s = {x, mXToColumn(x, width), std::isfinite(y) ? mYToRow(y, height) : NAN, false};
+						samples.push_back(s);
+						return s.v > -height && s.v < 2 * height;
+					};
+					double x = plot.from;
+					double y = plot.to;
+					if(!visit(x, y))
+					{
+						return stepper.evaluations();
+					}
+					while(x != to)
+					{
+						x = std::abs(to - x) > column ? x + step : to;
+						while((x - stepper.t()) * step > 0 && stepper.step(to))
+						{
+						}
+						if((x - stepper.t()) * step > 0)
+						{
+							break;
+						}
+						stepper.interpolate(x, y);
+						if(!visit(x, y))
+						{
+							break;
+						}
+					}
+					return stepper.evaluations();
+				};
+				//Backwards first, with the budget split by how much of the domain is on either side,
+				//then reversed in front of the rest without repeating the point.
+				const double share = std::min(std::max((plot.from - mXrange[0]) / (mXrange[1] - mXrange[0]), 0.0), 1.0);
+				std::vector<Sample> left;
+				const std::size_t used = solve(mXrange[0], std::size_t(budget * share), left);
+				out.assign(left.rbegin(), left.rend());
+				if(!out.empty())
+				{
+					out.pop_back();
+				}
+				solve(mXrange[1], budget - std::min(used, budget), out);
 			}
 
 			/**
-			 * @brief Pushes another function to be rendered on display().
+			 * @brief Evaluates the slope field at the points of a grid, row by row over the threads, and walks the points in order.
+			 * 
+			 * @param width The width of the graph, in dots.
+			 * @param height The height of the graph, in dots.
+			 * @param across How many dots apart the points are across.
+			 * @param down How many dots apart the points are down.
+			 * @param mark Called with the column & row of every point the field is defined at, and which way it points there on the screen,
+			 * 		as a unit vector in dots, going right (or down, where it's vertical).
+			 * 
+			 * @remarks The grid is centered on the graph.
 			 * 
-			 * @param fx The function to render.
-			 * @param funcChar The character to be used to draw the function.
 			 */
-			void addFunction(Func fx, char funcChar = '#')
+			template<typename Mark>
+			void mTraceField(int width, int height, double across, double down, Mark mark) const
 			{
-				mFunctions.push_back(std::make_pair(fx, funcChar));
+				if(!mField)
+				{
+					return;
+				}
+				const int columns = int(width / across);
+				const int rows = int(height / down);
+				const double u0 = (width - 1 - (columns - 1) * across) / 2;
+				const double v0 = (height - (rows - 1) * down) / 2;
+				//From dy/dx to rows per column.
+				const double scale = -height / (mYrange[1] - mYrange[0]) * (mXrange[1] - mXrange[0]) / std::max(width - 1, 1);
+				std::vector<double> slopes(std::size_t(std::max(columns, 0)) * std::max(rows, 0));
+				detail::parallel_for(std::size_t(std::max(rows, 0)), mThreads, [&](std::size_t j){
+					const double y = mRowToY(v0 + j * down, height);
+					for(int i = 0; i < columns; ++i)
+					{
+						slopes[j * columns + i] = scale * mField(mColumnToX(u0 + i * across, width), y);
+					}
+				}, mPool.get());
+				for(std::size_t k = 0; k < slopes.size(); ++k)
+				{
+					const double s = slopes[k];
+					const double u = u0 + double(k % columns) * across;
+					const double v = v0 + double(k / columns) * down;
+					if(std::isinf(s))
+					{
+						mark(u, v, 0.0, 1.0);
+					}
+					else if(!std::isnan(s))
+					{
+						const double length = std::hypot(1.0, s);
+						mark(u, v, 1 / length, s / length);
+					}
+				}
 			}
 
 			/**
-			 * @brief Resets all functions that were queued.
+			 * @brief Walks a curve as the lines that draw it.
+			 * 
+			 * @param curve The curve.
+			 * @param line Called with the columns & rows of the ends of each line, which may be off the screen.
+			 * 
+			 * @remarks Every pair of neighbouring samples is joined, unless the curve breaks in between:
+			 * 		where the function isn't defined (NAN or infinite), or at a jump or a pole mRefine() found,
+			 * 		so 1/x doesn't get a vertical line at 0. Lonely samples are lines from themselves to themselves.
 			 * 
 			 */
-			void clearFunctions()
+			template<typename Line>
+			static void mTrace(const std::vector<Sample> &curve, Line line)
 			{
-				mFunctions.clear();
+				for(std::size_t i = 0; i < curve.size(); ++i)
+				{
+					const Sample &s = curve[i];
+					if(!std::isfinite(s.v))
+					{
+						continue;
+					}
+					if(i + 1 == curve.size() || s.jump || !std::isfinite(curve[i + 1].v))
+					{
+						line(s.u, s.v, s.u, s.v);
+						continue;
+					}
+					line(s.u, s.v, curve[i + 1].u, curve[i + 1].v);
+				}
 			}
 
 			/**
-			 * @brief The main display call. Prints the final graph to the screen.
+			 * @brief Re-draws the frame buffer if anything changed, records the characters that came out different, and swaps it in to be printed.
 			 * 
 			 * @remarks This is horribly programmed. It's a hacky, inconsistent, memory-draining cesspool. I'm sorry.
 			 * 
 			 * @see Hell
 			 * 
 			 */
-			void display()
+			void mRender()
 			{
-				//Declare the screen, to be updated before the final print statement.
-				char screen[mTermHeight][mTermWidth];
+				if(!mDirty)
+				{
+					return;
+				}
+				mDirty = false;
 
-				//Clear the screen with ' ' characters.
+				//In the sub-character modes every "pixel" is a dot, several to a character.
+				const int cellWidth = mMode == Mode::Braille ? 2 : 1;
+				const int cellHeight = mMode == Mode::Braille ? 4 : mMode == Mode::HalfBlock ? 2 : 1;
+				const int width = mTermWidth * cellWidth;
+				const int height = mTermHeight * cellHeight;
+
+				//Clear the screen with ' ' characters (or no dots).
 				for(int i = 0; i < mTermHeight; ++i)
 				{
-					for(int j = 0; j < mTermWidth; ++j)
+					std::fill(mRow(i), mRow(i) + mRowBytes(), ' ');
+				}
+				std::fill(mDots.begin(), mDots.end(), 0);
+				auto plot = [&](int x, int y, char c){
+					if(mMode == Mode::Ascii)
 					{
-						screen[i][j] = ' ';
+						mRow(y)[x] = c;
 					}
-				}
-
+					else
+					{
+						mDots[std::size_t(y / cellHeight) * mTermWidth + x / cellWidth] |= mDotBit(x % cellWidth, y % cellHeight);
+					}
+				};
 				/*
-				These are lambdas that convert between the coordinate systems of the terminal & function.
+				These are lambdas that round the view transform's fractional dots (see mXToColumn()) to the ones that get drawn.
 				*/
-				auto pixelToX = [&](int val)->double{
-					return mMap(val, 0, mTermWidth-1, mXrange[0], mXrange[1]);
+				auto column = [&](double u)->int{
+					return int(std::lround(u));
 				};
-				//Unused, here for completion.
-				/*auto pixelToY = [&](int val)->double{
-					return mMap(val, 0, mTermHeight-1, mYrange[0], mYrange[1]);
-				};*/
-				auto xToPixel = [&](double val)->int{
-					return int(mMap(val, mXrange[0], mXrange[1], 0, mTermWidth));
+				//The bottom of the range maps one past the last row, so keep it on the screen.
+				auto row = [&](double v)->int{
+					return std::min(int(v), height - 1);
 				};
-				auto yToPixel = [&](double val)->int{
-					return int(mMap(val, mYrange[0], mYrange[1], mTermHeight, 0));
+				//Draws the part of a line between two fractional dots that's on the screen.
+				auto line = [&](double u0, double v0, double u1, double v1, char c){
+					if(!detail::clip_line(u0, v0, u1, v1, width - 1, height))
+					{
+						return;
+					}
+					const int steps = std::max(std::abs(column(u1) - column(u0)), std::abs(row(v1) - row(v0)));
+					plot(column(u0), row(v0), c);
+					for(int k = 1; k <= steps; ++k)
+					{
+						double w = double(k) / steps;
+						plot(column(u0 + (u1 - u0) * w), row(v0 + (v1 - v0) * w), c);
+					}
 				};
 				/*
 				------------
 				*/
 
 				//Get the positions of the axis, and make sure they're in-bounds (or don't render them)
-				int xaxis = yToPixel(0);
-				int yaxis = xToPixel(0);
+				double xaxis = mYToRow(0, height);
+				double yaxis = mXToColumn(0, width);
 				/*
 				xaxis is the y-position of the xaxis, and vice-versa, which is why these comparisons seem off.
 				Here we are just filling in the axis's with their respective character.
 				*/
-				if(yaxis >= 0 && yaxis < mTermWidth)
+				if(yaxis > -0.5 && yaxis < width - 0.5)
 				{
-					for(int i = 0; i < mTermHeight; ++i)
+					for(int i = 0; i < height; ++i)
 					{
-						screen[i][yaxis] = '|';
+						plot(column(yaxis), i, '|');
 					}
 				}
-				if(xaxis >= 0 && xaxis < mTermHeight)
+				if(xaxis >= 0 && xaxis <= height)
 				{
-					for(int i = 0; i < mTermWidth; ++i)
+					for(int i = 0; i < width; ++i)
 					{
-						screen[xaxis][i] = '-';
+						plot(i, row(xaxis), '-');
 					}
 				}
 				/*
 				--------------
 				*/
+
+				//The slope field, a character apart across & half as far down for every two characters of spacing.
+				const double across = double(mFieldSpacing * cellWidth);
+				const double down = std::max(mFieldSpacing / 2, 1) * double(cellHeight);
+				mTraceField(width, height, across, down, [&](double u, double v, double du, double dv){
+					if(mMode == Mode::Ascii)
+					{
+						//The slope as it looks, rising to the right, with characters twice as tall as they're wide; tan(22.5) & tan(67.5) split the glyphs.
+						const double rise = du == 0 ? INFINITY : -2 * dv / du;
+						const char glyph = std::abs(rise) < 0.41421356 ? '-' : std::abs(rise) > 2.41421356 ? '|' : rise > 0 ? '/' : '\\';
+						plot(column(u), row(v), glyph);
+						return;
+					}
+					const double reach = 0.4 * std::min(across, down);
+					line(u - du * reach, v - dv * reach, u + du * reach, v + dv * reach, '.');
+				});
 				
+				mSampleCurves(width, height);
+
 				//Update the screen w/ the functions.
-				for(auto &pair : mFunctions)
-				{
-					/*
-					For every function we're going to:
-					     * Go through each X value (Term coords).
-						 	 * Get the respective function-coordinate x position
-							 * Pass it through the function.
-							 * Assert that the y-value is not out of range.
-							 * Convert back to term coords.
-							 * If the pixel is too far from the previous pixel (and it's not the first execute),
-							 	 * Iterate through from the last pixel to the current pixel's y-coordinate.
-								 * Place a character at all points passed.
-								 This generates smooth lines.
-							 * Update the last pixel.
-							 * Set the pixel at the actual point. 
-					*/
-
-					//Set to max to avoid the first point being compared with whatever other initial value this may take on.
-					//(Try setting this to 0 and rendering x cubed.)
-					int last_pixel_y = INT32_MAX;
-
-					//Iterate through all x-values (term coords).
-					for(int i = 0; i < mTermWidth; ++i)
-					{
-						//Get the corresponding x-value in function-coordinates.
-						double val = pixelToX(i);
-						//Pass it through the function to get the output (y-value).
-						double result = pair.first(val);
-
-						//If the result is out of range, ignore and move on.
-						if(result < mYrange[0] || result > mYrange[1])
-						{
-							continue;
-						}
-						
-						//Otherwise, we're going to convert the point back to "pixel" coordinates.
-						int pixel_y = yToPixel(result);
+				for(std::size_t p = 0; p < mPlots.size(); ++p)
+				{
+					const char c = mPlots[p].character;
+					mTrace(mCurves[p], [&](double u0, double v0, double u1, double v1){
+						line(u0, v0, u1, v1, c);
+					});
+				}
 
-						//Checks if the last pixel is too far from the new pixel,
-							//AND that it's not the first iteration that something was drawn (The INT32_MAX check).
-						if((last_pixel_y > pixel_y || last_pixel_y < pixel_y) && last_pixel_y != INT32_MAX)
-						{
-							//For every pixel in between..
-							for(int j = last_pixel_y; 
-									j != pixel_y; 
-									//Inc or dec based on which will terminate the loop >w<.
-									j += (last_pixel_y > pixel_y) ? (-1) : (1))
-							{
-								//Set that pixel.
-								screen[j][i] = pair.second;
-							}
-						}
-						//Set the las drawn pixel.
-						last_pixel_y = pixel_y;
-						
-						//And finally, actually, draw the real, actual pixel that was supposed to be drawn.
-						screen[pixel_y][i] = pair.second;
+				//Turn the dots into characters.
+				if(mMode != Mode::Ascii)
+				{
+					for(std::size_t i = 0; i < mDots.size(); ++i)
+					{
+						mEncode(mScreen.data() + mCell(i), mDots[i]);
 					}
 				}
 
-				//Render everything in one std::cout call.
-				std::stringstream ss;
-				for(int i = 0; i < mTermHeight; ++i)
+				//Diff against the last frame, row by row, joining runs of changes less than a cursor move apart.
+				const std::size_t cell = mCellBytes();
+				const std::size_t gap = 4;
+				mChanges.clear();
+				for(std::size_t r = 0; r < std::size_t(mTermHeight); ++r)
 				{
-					for(int j = 0; j < mTermWidth; ++j)
+					const std::size_t rowStart = r * mTermWidth;
+					if(std::equal(mScreen.begin() + mCell(rowStart), mScreen.begin() + mCell(rowStart) + mRowBytes(), mShown.begin() + mCell(rowStart)))
+					{
+						continue;
+					}
+					for(std::size_t i = rowStart; i < rowStart + mTermWidth; ++i)
 					{
-						//Push every character into a string stream...
-						ss << screen[i][j];
+						if(std::equal(mScreen.begin() + mCell(i), mScreen.begin() + mCell(i) + cell, mShown.begin() + mCell(i)))
+						{
+							continue;
+						}
+						if(!mChanges.empty() && mChanges.back().first >= rowStart && i - mChanges.back().second < gap)
+						{
+							mChanges.back().second = i + 1;
+						}
+						else
+						{
+							mChanges.push_back(std::make_pair(i, i + 1));
+						}
 					}
-					//..append newlines as needed...
-					ss << '\n';
 				}
-				//..and print!
-				std::cout << ss.str();
+				mShown.swap(mScreen);
+			}
+
+			/**
+			 * @brief The view transform, from x to a column of dots.
+			 * 
+			 * @param x The x-coordinate.
+			 * @param width The width of the graph, in dots.
+			 * @return double The column, fractional and possibly off the screen. The domain spans columns 0 to width-1.
+			 */
+			double mXToColumn(double x, int width) const
+			{
+				return (x - mXrange[0]) * (width - 1) / (mXrange[1] - mXrange[0]);
+			}
+
+			/**
+			 * @brief The inverse view transform, from a column of dots to x.
+			 * 
+			 * @see mXToColumn()
+			 */
+			double mColumnToX(double u, int width) const
+			{
+				return mXrange[0] + u * (mXrange[1] - mXrange[0]) / std::max(width - 1, 1);
+			}
+
+			/**
+			 * @brief The view transform, from y to a row of dots.
+			 * 
+			 * @param y The y-coordinate.
+			 * @param height The height of the graph, in dots.
+			 * @return double The row, fractional and possibly off the screen. The range spans rows height (at the bottom) to 0.
+			 */
+			double mYToRow(double y, int height) const
+			{
+				return (mYrange[1] - y) * height / (mYrange[1] - mYrange[0]);
 			}
-		private:
-			std::vector<std::pair<Func, char>> mFunctions;
-			int mTermWidth;
-			int mTermHeight;
-			double mXrange[2];
-			double mYrange[2];
 
-			long mMap(long value, long lower, long upper, long newlower, long newupper)
+			/**
+			 * @brief The inverse view transform, from a row of dots to y.
+			 * 
+			 * @see mYToRow()
+			 */
+			double mRowToY(double v, int height) const
 			{
-				return (value - lower) * (newupper - newlower) / (upper - lower) + newlower;
+				return mYrange[1] - v * (mYrange[1] - mYrange[0]) / height;
 			}
 		};
 		/////////END GRAPHER CLASS DEF/////////////
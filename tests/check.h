@@ -0,0 +1,20 @@
+//Checks shared by the tests. Each test is a program that prints every check and returns how many failed.
+
+#include <cmath>
+#include <cstdio>
+
+static int failures = 0;
+
+//Passes if value is within tolerance of reference. NAN never passes.
+static void check(const char *name, double value, double reference, double tolerance)
+{
+	const bool pass = std::abs(value - reference) <= tolerance;
+	std::printf("%s %s: %.17g, expected %.17g to within %g\n", pass ? "pass" : "FAIL", name, value, reference, tolerance);
+	failures += !pass;
+}
+
+static void check(const char *name, bool pass)
+{
+	std::printf("%s %s\n", pass ? "pass" : "FAIL", name);
+	failures += !pass;
+}
@@ -0,0 +1,39 @@
+//Arc lengths and areas of graphs, parametric and polar curves with closed forms.
+
+#include "../include/Calculus.h"
+#include "check.h"
+
+using namespace calc;
+
+int main()
+{
+	const double pi = 3.14159265358979323846;
+
+	check("arc_length of 2x + 1 on [0, 3]", arc_length([](double x){ return 2 * x + 1; }, 0, 3).value, 3 * std::sqrt(5.0), 1e-11);
+	//The derivative is infinite at 0, and sqrt is NaN left of it, so the stencil has to stay inside.
+	check("arc_length of sqrt on [0, 1]", arc_length([](double x){ return std::sqrt(x); }, 0, 1).value,
+		  (2 * std::sqrt(5.0) + std::log(2 + std::sqrt(5.0))) / 4, 1e-10);
+	Estimate semicircle = arc_length([](double x){ return std::sqrt(1 - x * x); }, -1, 1);
+	check("arc_length of a semicircle", semicircle.value, pi, 1e-5);
+	check("arc_length of a semicircle error estimate", semicircle.error >= std::abs(semicircle.value - pi));
+	check("arc_length with a hole's error is infinite", std::isinf(arc_length([](double x){ return x > 0.3 && x < 0.4 ? NAN : x; }, 0, 1).error));
+
+	auto cosine = [](double t){ return std::cos(t); };
+	auto sine = [](double t){ return std::sin(t); };
+	check("arc_length_parametric of the unit circle", arc_length_parametric(cosine, sine, 0, 2 * pi).value, 2 * pi, 1e-10);
+	//An ellipse's circumference is an elliptic integral; this is its value for semi-axes 2 and 1.
+	check("arc_length_parametric of an ellipse", arc_length_parametric([](double t){ return 2 * std::cos(t); }, sine, 0, 2 * pi).value,
+		  9.68844822054767619842, 1e-9);
+	check("arc_length_polar of a circle", arc_length_polar([](double){ return 3; }, 0, 2 * pi).value, 6 * pi, 1e-10);
+	//Half of it, to keep the cusp at pi on a bound.
+	check("arc_length_polar of a cardioid", 2 * arc_length_polar([](double t){ return 1 + std::cos(t); }, 0, pi).value, 8, 1e-8);
+
+	check("area_parametric of the unit circle", area_parametric(cosine, sine, 0, 2 * pi).value, pi, 1e-10);
+	check("area_parametric clockwise is negative", area_parametric(sine, cosine, 0, 2 * pi).value, -pi, 1e-10);
+	check("area_parametric of an ellipse", area_parametric([](double t){ return 2 * std::cos(t); }, sine, 0, 2 * pi).value, 2 * pi, 1e-10);
+	check("area_polar of a circle", area_polar([](double){ return 3; }, 0, 2 * pi).value, 9 * pi, 1e-10);
+	check("area_polar of a cardioid", area_polar([](double t){ return 1 + std::cos(t); }, 0, 2 * pi).value, 1.5 * pi, 1e-10);
+
+	std::printf("%d failed\n", failures);
+	return failures;
+}
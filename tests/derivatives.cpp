@@ -0,0 +1,43 @@
+//The finite difference and complex-step derivatives against derivatives with known values.
+
+#include "../include/Calculus.h"
+#include "check.h"
+
+using namespace calc;
+
+int main()
+{
+	const DiffScheme schemes[] = {DiffScheme::Central, DiffScheme::FivePoint, DiffScheme::Richardson};
+	const char *names[] = {"Central", "FivePoint", "Richardson"};
+	const double tolerances[] = {1e-9, 1e-12, 1e-12};
+	for(int s = 0; s < 3; ++s)
+	{
+		std::string name = names[s];
+		Estimate sine = derivative_estimate([](double x){ return std::sin(x); }, 1, schemes[s]);
+		check((name + " sin' at 1").c_str(), sine.value, std::cos(1.0), tolerances[s]);
+		check((name + " sin' at 1 error estimate").c_str(), sine.error >= std::abs(sine.value - std::cos(1.0)));
+		//The step scales with x, so a large x keeps the relative accuracy.
+		Estimate exponential = derivative_estimate([](double x){ return std::exp(x / 1000); }, 5000, schemes[s]);
+		check((name + " (e^(x/1000))' at 5000").c_str(), exponential.value / (std::exp(5.0) / 1000), 1, tolerances[s] * 10);
+	}
+
+	Options richardson;
+	richardson.diff = DiffScheme::Richardson;
+	richardson.digits = -1;
+	Func cube = derivative([](double x){ return x * x * x; }, richardson);
+	check("Richardson (x^3)' at 2 as a function", cube(2), 12, 1e-10);
+
+	//No subtraction, so the step can be tiny and the result is exact to rounding.
+	auto analytic = [](std::complex<double> z){ return std::exp(z) / std::sqrt(std::pow(std::sin(z), 3) + std::pow(std::cos(z), 3)); };
+	double x = 1.5;
+	double reference = derivative_estimate([&](double t){ return std::real(analytic(t)); }, x).value;
+	check("complex step of Squire and Trapp's function at 1.5", derivative_complex_step(analytic, x), reference, 1e-8);
+	check("complex step e^x at 0", derivative_complex_step([](std::complex<double> z){ return std::exp(z); }, 0), 1, 1e-15);
+	check("complex step x^2 at 3 as a function",
+		  derivative_complex_step([](std::complex<double> z){ return z * z; })(3), 6, 1e-15);
+	check("complex-step Newton root of x^2 - 2", roots_complex_step([](std::complex<double> z){ return z * z - 2.0; }, 1),
+		  std::sqrt(2.0), 1e-14);
+
+	std::printf("%d failed\n", failures);
+	return failures;
+}
@@ -0,0 +1,310 @@
+//The frames Grapher draws, and what it prints to update them.
+
+#include "../include/Calculus.h"
+#include "check.h"
+
+#include <algorithm>
+#include <sstream>
+
+using namespace calc;
+using calc::util::Grapher;
+
+//Everything a call prints to std::cout.
+template<typename F>
+static std::string printed(F &&call)
+{
+	std::ostringstream out;
+	std::streambuf *old = std::cout.rdbuf(out.rdbuf());
+	call();
+	std::cout.rdbuf(old);
+	return out.str();
+}
+
+static std::vector<std::string> lines(const std::string &text)
+{
+	std::vector<std::string> ret;
+	std::istringstream in(text);
+	for(std::string line; std::getline(in, line);)
+	{
+		ret.push_back(line);
+	}
+	return ret;
+}
+
+//The characters of a line drawn in a sub-character mode, 3 bytes of UTF-8 each.
+static std::vector<std::string> glyphs(const std::string &line)
+{
+	std::vector<std::string> ret;
+	for(std::size_t i = 0; i + 3 <= line.size(); i += 3)
+	{
+		ret.push_back(line.substr(i, 3));
+	}
+	return ret;
+}
+
+int main()
+{
+	Grapher g;
+	g.setDomain(-20, 20);
+	g.setRange(-20, 20);
+	g.setOutputDimensions(60, 20);
+	g.addFunction([](double){ return -20; }, '_');
+
+	//One line per row, every one the full width, with both axes and the bottom of the range on the last row.
+	std::vector<std::string> frame = lines(printed([&]{ g.display(); }));
+	check("frame height", double(frame.size()), 20, 0);
+	bool widths = true;
+	for(const std::string &line : frame)
+	{
+		widths = widths && line.size() == 60;
+	}
+	check("frame width", widths);
+	check("x axis", std::any_of(frame.begin(), frame.end(), [](const std::string &line){
+		return std::count(line.begin(), line.end(), '-') >= 59;
+	}));
+	bool yAxis = false;
+	for(std::size_t c = 0; c < 60 && !yAxis && frame.size() == 20; ++c)
+	{
+		int bars = 0;
+		for(const std::string &line : frame)
+		{
+			bars += line.size() == 60 && line[c] == '|';
+		}
+		yAxis = bars >= 18;
+	}
+	check("y axis", yAxis);
+	check("bottom of the range on the last row", !frame.empty() && std::count(frame.back().begin(), frame.back().end(), '_') >= 58);
+
+	//Nothing changed, so the same frame again, and a refresh with no rows in it.
+	check("display() again is the same frame", lines(printed([&]{ g.display(); })) == frame);
+	std::string still = printed([&]{ g.refresh(); });
+	check("refresh() with nothing changed writes no rows", std::count(still.begin(), still.end(), '\n') == 0);
+
+	//A horizontal line only changes its own row, rewritten in one run.
+	g.addFunction([](double){ return 10; }, '=');
+	std::string moved = printed([&]{ g.refresh(); });
+	check("refresh() writes only the changed row", moved == "\x1b[20A\r\x1b[5B" + std::string(60, '=') + "\r\x1b[15B");
+
+	//A short mark moving along a row: one run where it was and one where it is, the first carrying the unchanged axis
+	//between its characters instead of moving the cursor over it.
+	double at = 0;
+	Grapher mark;
+	mark.setDomain(-20, 20);
+	mark.setRange(-20, 20);
+	mark.setOutputDimensions(60, 20);
+	mark.addFunction([&](double x){ return std::abs(x - at) < 1.5 ? 10.0 : NAN; }, '*');
+	printed([&]{ mark.display(); });
+	at = 12;
+	mark.invalidate();
+	std::string runs = printed([&]{ mark.refresh(); });
+	check("refresh() writes runs of changed characters", std::count(runs.begin(), runs.end(), '\n') == 0 &&
+		  std::count(runs.begin(), runs.end(), 'C') == 2 && runs.size() < 60);
+	check("nearby changes merge into one run", runs.find("   |  ") != std::string::npos && runs.find("*****") != std::string::npos);
+	check("refresh() again writes nothing", printed([&]{ mark.refresh(); }).empty());
+
+	//Every frame is played and timed.
+	int updates = 0;
+	Grapher::FrameTimes times;
+	printed([&]{ times = mark.animate(5, [&](std::size_t i){ ++updates; at = double(i); }, 1000); });
+	std::size_t binned = 0;
+	for(std::size_t count : times.histogram)
+	{
+		binned += count;
+	}
+	check("animate() plays every frame", updates == 5 && times.frames == 5 && binned == 5);
+	check("frame time percentiles", times.percentile(0) <= times.percentile(100) && times.percentile(100) <= times.longest + 1);
+
+	//The sub-character modes keep every row the same number of bytes, and draw the axes as rows and columns of dots.
+	const std::string blank = "\xE2\xA0\x80";
+	for(Grapher::Mode mode : {Grapher::Mode::Braille, Grapher::Mode::HalfBlock})
+	{
+		const std::string name = mode == Grapher::Mode::Braille ? "Braille" : "half-block";
+		Grapher dots;
+		dots.setDomain(-20, 20);
+		dots.setRange(-20, 20);
+		dots.setOutputDimensions(60, 20);
+		dots.setMode(mode);
+		std::vector<std::string> rows = lines(printed([&]{ dots.display(); }));
+		check((name + " frame height").c_str(), double(rows.size()), 20, 0);
+		bool encoded = true;
+		bool axis = false;
+		for(const std::string &line : rows)
+		{
+			std::vector<std::string> cells = glyphs(line);
+			encoded = encoded && line.size() == 180;
+			for(const std::string &cell : cells)
+			{
+				//U+2800 to U+28FF for Braille, the blank and U+2580, U+2584 or U+2588 for the half blocks.
+				const bool braille = cell[0] == '\xE2' && (unsigned char)cell[1] >= 0xA0 && (unsigned char)cell[1] <= 0xA3;
+				const bool half = cell == blank || cell == "\xE2\x96\x80" || cell == "\xE2\x96\x84" || cell == "\xE2\x96\x88";
+				encoded = encoded && (mode == Grapher::Mode::Braille ? braille : half);
+			}
+			axis = axis || std::count(cells.begin(), cells.end(), blank) <= 1;
+		}
+		check((name + " frame is 3-byte glyphs").c_str(), encoded);
+		check((name + " x axis").c_str(), axis);
+		dots.setMode(Grapher::Mode::Ascii);
+		dots.addFunction([](double){ return -20; }, '_');
+		check((name + " back to Ascii is the Ascii frame").c_str(), lines(printed([&]{ dots.display(); })) == frame);
+	}
+
+	//A jump is left open instead of joined with a vertical line, and undefined values leave a gap.
+	Grapher jumps;
+	jumps.setDomain(-20, 20);
+	jumps.setRange(-20, 20);
+	jumps.setOutputDimensions(60, 20);
+	jumps.addFunction([](double x){ return x < 5.3 ? -10 : 10; }, '#');
+	jumps.addFunction([](double x){ return x < -10.3 ? std::sqrt(-1.0) : 15.0; }, '$');
+	std::vector<std::string> steps = lines(printed([&]{ jumps.display(); }));
+	bool open = steps.size() == 20;
+	for(std::size_t r = 6; r < 15 && open; ++r)
+	{
+		open = steps[r].find('#') == std::string::npos;
+	}
+	check("a jump isn't joined", open);
+	check("undefined values aren't drawn", steps.size() == 20 && steps[2].find('$') >= 14 && steps[2].find('$') != std::string::npos);
+
+	//A line that leaves the range is clipped to the edge of the screen, not dropped.
+	Grapher steep;
+	steep.setDomain(-20, 20);
+	steep.setRange(-20, 20);
+	steep.setOutputDimensions(60, 20);
+	steep.addFunction([](double x){ return 7 * x; }, '/');
+	std::vector<std::string> clipped = lines(printed([&]{ steep.display(); }));
+	check("clipped line reaches the top and bottom rows", clipped.size() == 20 &&
+		  clipped.front().find('/') != std::string::npos && clipped.back().find('/') != std::string::npos);
+
+	//Zooming around a point is the same as setting the smaller domain and range.
+	steep.zoom(2, 4, -2);
+	Grapher zoomed;
+	zoomed.setDomain(-8, 12);
+	zoomed.setRange(-11, 9);
+	zoomed.setOutputDimensions(60, 20);
+	zoomed.addFunction([](double x){ return 7 * x; }, '/');
+	check("zoom(2) around (4, -2)", printed([&]{ steep.display(); }) == printed([&]{ zoomed.display(); }));
+
+	//The budget caps the evaluations on top of the grid of every 4th column and the ends of the 16-column blocks.
+	int evaluations = 0;
+	Grapher budget;
+	budget.setDomain(-20, 20);
+	budget.setRange(-20, 20);
+	budget.setOutputDimensions(60, 20);
+	budget.addFunction([&](double x){ ++evaluations; return 15 * std::sin(x); }, '*');
+	printed([&]{ budget.display(); });
+	const int refined = evaluations;
+	budget.setSampleBudget(10);
+	evaluations = 0;
+	printed([&]{ budget.display(); });
+	check("sample budget caps evaluations", evaluations <= 60 / 4 + 2 * 4 + 10 && evaluations < refined);
+
+	//Every way of printing a frame gives the same bytes, straight from the frame buffer.
+	Grapher out;
+	out.setOutputDimensions(40, 10);
+	out.addFunction([](double x){ return x; }, '/');
+	const std::string shown = printed([&]{ out.display(); });
+	check("frame() is what display() prints", std::string(out.frame(), out.frameBytes()) == shown && shown.size() == 41 * 10);
+	std::ostringstream stream;
+	out.display(stream);
+	check("display(std::ostream&)", stream.str() == shown);
+	std::vector<char> buffer(shown.size(), '?');
+	check("display(buffer) too small writes nothing", out.display(buffer.data(), buffer.size() - 1) == shown.size() &&
+		  std::count(buffer.begin(), buffer.end(), '?') == std::ptrdiff_t(buffer.size()));
+	check("display(buffer)", out.display(buffer.data(), buffer.size()) == shown.size() && std::string(buffer.begin(), buffer.end()) == shown);
+	std::FILE *file = std::tmpfile();
+#if defined(CALC_POSIX)
+	out.display(fileno(file));
+#else
+	out.display(file);
+#endif
+	std::rewind(file);
+	std::string written(shown.size() + 1, '\0');
+	written.resize(std::fread(&written[0], 1, written.size(), file));
+	std::fclose(file);
+	check("display(FileHandle)", written == shown);
+	//A new frame handed out by frame() may never have reached the terminal, so refresh() prints all of it.
+	out.addFunction([](double){ return 5; }, '=');
+	out.frame();
+	check("refresh() after frame() prints the whole frame", printed([&]{ out.refresh(); }) == std::string(out.frame(), out.frameBytes()));
+
+	//A polar curve is the parametric curve (r cos t, r sin t), and a circle reaches the rows above and below the axis.
+	Grapher polar;
+	polar.setOutputDimensions(60, 20);
+	polar.addPolar([](double){ return 8; }, 0, 2 * 3.14159265358979323846, 'o');
+	Grapher parametric;
+	parametric.setOutputDimensions(60, 20);
+	parametric.addParametric([](double t){ return 8 * std::cos(t); }, [](double t){ return 8 * std::sin(t); }, 0, 2 * 3.14159265358979323846, 'o');
+	std::vector<std::string> circle = lines(printed([&]{ polar.display(); }));
+	check("polar circle is the parametric one", lines(printed([&]{ parametric.display(); })) == circle);
+	check("circle spans the rows of its diameter", circle.size() == 20 && circle[2].find('o') != std::string::npos &&
+		  circle[17].find('o') != std::string::npos && circle[1].find('o') == std::string::npos && circle[19].find('o') == std::string::npos);
+
+	//Slope marks lean with the sign of the slope, and a trajectory of y' = f(x) is the graph of its antiderivative.
+	Grapher field;
+	field.setOutputDimensions(60, 20);
+	field.setSlopeField([](double x, double){ return x; });
+	std::vector<std::string> slopes = lines(printed([&]{ field.display(); }));
+	bool lean = slopes.size() == 20;
+	int marks = 0;
+	const std::size_t axis = slopes.empty() ? 0 : slopes[0].find("-|-") + 1;
+	for(const std::string &line : slopes)
+	{
+		for(std::size_t c = 0; c < line.size() && lean; ++c)
+		{
+			lean = (line[c] != '/' || c > axis) && (line[c] != '\\' || c < axis);
+			marks += line[c] == '/' || line[c] == '\\';
+		}
+	}
+	check("slope field leans with the slope", lean && marks > 50);
+	Grapher trajectory;
+	trajectory.setOutputDimensions(60, 20);
+	trajectory.addTrajectory([](double x, double){ return x / 2; }, 0, -6, '*');
+	Grapher antiderivative;
+	antiderivative.setOutputDimensions(60, 20);
+	antiderivative.addFunction([](double x){ return x * x / 4 - 6; }, '*');
+	std::vector<std::string> solved = lines(printed([&]{ trajectory.display(); }));
+	std::vector<std::string> exact = lines(printed([&]{ antiderivative.display(); }));
+	//The two are sampled differently, so every mark of each only has to be next to one of the other's.
+	auto near = [](const std::vector<std::string> &a, const std::vector<std::string> &b){
+		auto marked = [&](std::size_t r, std::size_t c){
+			return r < b.size() && c < b[r].size() && b[r][c] == '*';
+		};
+		for(std::size_t r = 0; r < a.size(); ++r)
+		{
+			for(std::size_t c = 0; c < a[r].size(); ++c)
+			{
+				bool found = a[r][c] != '*';
+				for(std::size_t dr = 0; dr < 3 && !found; ++dr)
+				{
+					for(std::size_t dc = 0; dc < 3 && !found; ++dc)
+					{
+						found = r + dr >= 1 && c + dc >= 1 && marked(r + dr - 1, c + dc - 1);
+					}
+				}
+				if(!found)
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	};
+	check("trajectory follows the solution", solved.size() == 20 && near(solved, exact) && near(exact, solved));
+
+	//The threads only sample; the frame doesn't depend on how many there are.
+	Grapher wave;
+	wave.setOutputDimensions(120, 30);
+	wave.addFunction([](double x){ return 8 * std::sin(x); }, '*');
+	wave.addFunction([](double x){ return x * x / 4 - 5; }, '+');
+	const std::string serial = printed([&]{ wave.display(); });
+	wave.setThreads(4);
+	wave.invalidate();
+	check("4 threads draw the same frame", printed([&]{ wave.display(); }) == serial);
+	wave.invalidate();
+	check("and again on the same threads", printed([&]{ wave.display(); }) == serial);
+	field.setThreads(4);
+	field.invalidate();
+	check("4 threads draw the same slope field", lines(printed([&]{ field.display(); })) == slopes);
+
+	std::printf("%d failed\n", failures);
+	return failures;
+}
@@ -0,0 +1,162 @@
+//The image helpers, and PNG & PPM files read back and checked byte by byte.
+
+#include "../include/Calculus.h"
+#include "check.h"
+
+#include <fstream>
+#include <iterator>
+
+using namespace calc;
+using calc::util::Color;
+using calc::util::Grapher;
+using calc::util::Raster;
+
+static std::vector<std::uint8_t> bytes(const std::string &text)
+{
+	return std::vector<std::uint8_t>(text.begin(), text.end());
+}
+
+static std::vector<std::uint8_t> read(const std::string &path)
+{
+	std::ifstream in(path, std::ios::binary);
+	return std::vector<std::uint8_t>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+static std::uint32_t be32(const std::uint8_t *from)
+{
+	return std::uint32_t(from[0]) << 24 | std::uint32_t(from[1]) << 16 | std::uint32_t(from[2]) << 8 | from[3];
+}
+
+int main()
+{
+	//The standard check values.
+	std::vector<std::uint8_t> digits = bytes("123456789");
+	check("crc32 of 123456789", detail::crc32(digits.data(), digits.size()) == 0xCBF43926);
+	check("crc32 continues", detail::crc32(digits.data() + 4, 5, detail::crc32(digits.data(), 4)) == 0xCBF43926);
+	std::vector<std::uint8_t> wikipedia = bytes("Wikipedia");
+	check("adler32 of Wikipedia", detail::adler32(wikipedia.data(), wikipedia.size()) == 0x11E60398);
+	check("adler32 continues", detail::adler32(wikipedia.data() + 3, 6, detail::adler32(wikipedia.data(), 3)) == 0x11E60398);
+	//Enough bytes for adler32's sums to wrap around the modulus.
+	std::vector<std::uint8_t> ones(100000, 0xFF);
+	std::uint32_t a = 1, b = 0;
+	for(std::uint8_t byte : ones)
+	{
+		a = (a + byte) % 65521;
+		b = (b + a) % 65521;
+	}
+	check("adler32 of 100000 0xFF bytes", detail::adler32(ones.data(), ones.size()) == (b << 16 | a));
+
+	double u0 = -5, v0 = 5, u1 = 15, v1 = 5;
+	check("clip_line across the rectangle", detail::clip_line(u0, v0, u1, v1, 10, 10) && u0 == 0 && u1 == 10 && v0 == 5 && v1 == 5);
+	u0 = 5, v0 = -10, u1 = 5, v1 = 20;
+	check("clip_line vertical", detail::clip_line(u0, v0, u1, v1, 10, 10) && v0 == 0 && v1 == 10 && u0 == 5);
+	u0 = 2, v0 = 3, u1 = 4, v1 = 6;
+	check("clip_line inside is unchanged", detail::clip_line(u0, v0, u1, v1, 10, 10) && u0 == 2 && v0 == 3 && u1 == 4 && v1 == 6);
+	u0 = -5, v0 = -5, u1 = 15, v1 = 15;
+	check("clip_line diagonal", detail::clip_line(u0, v0, u1, v1, 10, 10) && u0 == 0 && v0 == 0 && u1 == 10 && v1 == 10);
+	u0 = -10, v0 = 5, u1 = 5, v1 = 20;
+	check("clip_line missing the rectangle", !detail::clip_line(u0, v0, u1, v1, 10, 10));
+	u0 = 12, v0 = 0, u1 = 12, v1 = 10;
+	check("clip_line parallel outside", !detail::clip_line(u0, v0, u1, v1, 10, 10));
+
+	//A straight line keeps its ends, a spike sticking out further than the tolerance is kept, and one within it isn't.
+	std::vector<double> straight = {0, 0, 1, 1, 2, 2, 3, 3};
+	check("decimate a straight line", detail::decimate(straight, 0.1) == std::vector<bool>{true, false, false, true});
+	std::vector<double> spike = {0, 0, 1, 0, 2, 1, 3, 0, 4, 0};
+	check("decimate keeps a spike", detail::decimate(spike, 0.5) == std::vector<bool>{true, false, true, false, true});
+	check("decimate drops a spike within the tolerance", detail::decimate(spike, 2) == std::vector<bool>{true, false, false, false, true});
+	check("decimate nothing", detail::decimate({}, 1).empty());
+
+	//More than one stored block's worth of pixels, so the PNG has several.
+	Raster image(300, 200);
+	image.line(0, 0, 299, 199, Color{255, 0, 0, 255});
+	image.save("image_test.png");
+	std::vector<std::uint8_t> png = read("image_test.png");
+	std::remove("image_test.png");
+	static const std::uint8_t signature[8] = {137, 'P', 'N', 'G', '\r', '\n', 26, '\n'};
+	check("PNG signature", png.size() > 8 && std::equal(signature, signature + 8, png.begin()));
+	bool crcs = true;
+	std::vector<std::uint8_t> zlib;
+	std::vector<std::string> chunks;
+	for(std::size_t at = 8; at + 12 <= png.size();)
+	{
+		const std::uint32_t length = be32(&png[at]);
+		if(at + 12 + length > png.size())
+		{
+			crcs = false;
+			break;
+		}
+		chunks.push_back(std::string(png.begin() + at + 4, png.begin() + at + 8));
+		crcs = crcs && detail::crc32(&png[at + 4], length + 4) == be32(&png[at + 8 + length]);
+		if(chunks.back() == "IHDR")
+		{
+			check("PNG size", be32(&png[at + 8]) == 300 && be32(&png[at + 12]) == 200);
+		}
+		if(chunks.back() == "IDAT")
+		{
+			zlib.insert(zlib.end(), png.begin() + at + 8, png.begin() + at + 8 + length);
+		}
+		at += 12 + length;
+	}
+	check("PNG chunks", chunks == std::vector<std::string>{"IHDR", "IDAT", "IEND"});
+	check("PNG chunk CRCs", crcs);
+
+	//Undo the stored blocks, and the rows are the image's with a filter byte of 0 in front.
+	std::vector<std::uint8_t> raw;
+	bool stored = zlib.size() > 6;
+	std::size_t at = 2;
+	for(bool last = false; stored && !last;)
+	{
+		last = zlib[at] & 1;
+		const std::size_t length = zlib[at + 1] | zlib[at + 2] << 8;
+		stored = (zlib[at] >> 1) == 0 && std::size_t(zlib[at + 3] | zlib[at + 4] << 8) == (~length & 0xFFFF) && at + 5 + length + 4 <= zlib.size();
+		if(stored)
+		{
+			raw.insert(raw.end(), zlib.begin() + at + 5, zlib.begin() + at + 5 + length);
+			at += 5 + length;
+		}
+	}
+	check("PNG stored blocks", stored && at + 4 == zlib.size());
+	check("PNG zlib adler32", stored && detail::adler32(raw.data(), raw.size()) == be32(&zlib[at]));
+	bool rows = raw.size() == 200 * (300 * 4 + 1);
+	for(int row = 0; row < 200 && rows; ++row)
+	{
+		const std::uint8_t *line = &raw[row * (300 * 4 + 1)];
+		rows = line[0] == 0 && std::equal(line + 1, line + 1 + 300 * 4, image.data() + row * 300 * 4);
+	}
+	check("PNG rows", rows);
+
+	image.save("image_test.ppm");
+	std::vector<std::uint8_t> ppm = read("image_test.ppm");
+	std::remove("image_test.ppm");
+	const std::string header = "P6\n300 200\n255\n";
+	check("PPM size", double(ppm.size()), double(header.size() + 300 * 200 * 3), 0);
+	check("PPM header", ppm.size() > header.size() && std::equal(header.begin(), header.end(), ppm.begin()));
+	check("PPM drops opacity", ppm.size() > header.size() + 3 && ppm[header.size()] == image.data()[0] &&
+		  ppm[header.size() + 3] == image.data()[4]);
+
+	//A straight line is decimated down to its ends, and clipped to the image.
+	Grapher g;
+	g.addFunction([](double x){ return 2 * x; });
+	g.save("image_test.svg", 400, 300);
+	std::vector<std::uint8_t> svg = read("image_test.svg");
+	std::remove("image_test.svg");
+	const std::string text(svg.begin(), svg.end());
+	check("SVG document", text.compare(0, 4, "<svg") == 0 && text.find("</svg>") != std::string::npos);
+	const std::size_t polyline = text.find("<polyline");
+	check("SVG line is one segment", polyline != std::string::npos && text.find("<polyline", polyline + 1) == std::string::npos &&
+		  std::count(text.begin() + polyline, text.begin() + text.find("/>", polyline), ',') == 2);
+	bool unknown = false;
+	try
+	{
+		g.save("image_test.gif", 400, 300);
+	}
+	catch(const std::invalid_argument &)
+	{
+		unknown = true;
+	}
+	check("other extensions throw", unknown);
+
+	std::printf("%d failed\n", failures);
+	return failures;
+}
@@ -0,0 +1,55 @@
+//Interval arithmetic, and the root finding and integration built on it, which must enclose the exact answers.
+
+#include "../include/Calculus.h"
+#include "check.h"
+
+using namespace calc;
+
+int main()
+{
+	const double pi = 3.14159265358979323846;
+
+	//Outward rounding: 0.1 isn't a double, but [0.1, 0.1] * 3 still contains 0.3.
+	Interval tenth = Interval(0.1) * 3;
+	check("0.1 * 3 encloses 0.3", tenth.contains(0.3) && tenth.width() > 0);
+	Interval x(-1, 2);
+	check("pow([-1, 2], 2) is [0, 4]", pow(x, 2).lower() == 0 && pow(x, 2).contains(4) && pow(x, 2).upper() < 4.000001);
+	check("[-1, 2] * [-1, 2] encloses [-2, 4]", (x * x).contains(-2) && (x * x).contains(4));
+	check("sin on [0, 4] reaches 1", sin(Interval(0, 4)).upper() >= 1);
+	check("exp is increasing", exp(x).contains(std::exp(-1.0)) && exp(x).contains(std::exp(2.0)));
+	check("1 / [1, 2] is [0.5, 1]", (1 / Interval(1, 2)).contains(0.5) && (1 / Interval(1, 2)).contains(1));
+	check("1 / [-1, 1] is entire", std::isinf((1 / x).width()));
+	check("sqrt of negatives is empty", sqrt(Interval(-2, -1)).empty());
+
+	//Roots of sin on [1, 10] are pi, 2 pi and 3 pi, each proven unique.
+	std::vector<RootEnclosure> roots = roots_interval([](auto t){ return sin(t); }, 1, 10);
+	check("sin has 3 roots in [1, 10]", roots.size() == 3);
+	for(std::size_t k = 0; k < roots.size() && k < 3; ++k)
+	{
+		check("root enclosed", roots[k].unique && roots[k].bounds.contains((k + 1) * pi) && roots[k].bounds.width() < 1e-6);
+	}
+	//A double root can't be proven unique, but is still enclosed.
+	std::vector<RootEnclosure> doubled = roots_interval([](auto t){ return (t - 1) * (t - 1); }, 0, 3);
+	bool enclosed = false;
+	for(const RootEnclosure &root : doubled)
+	{
+		enclosed = enclosed || root.bounds.contains(1);
+	}
+	check("double root enclosed", enclosed);
+	check("no roots of x^2 + 1", roots_interval([](auto t){ return t * t + 1; }, -5, 5).empty());
+
+	Interval area = integral_verified([](auto t){ return sin(t); }, 0, pi);
+	check("verified sin on [0, pi] encloses 2", area.contains(2));
+	check("verified sin on [0, pi] width", area.width(), 0, 1e-6);
+	Interval growth = integral_verified([](auto t){ return exp(t); }, 0, 1);
+	check("verified e^x on [0, 1] encloses e - 1", growth.contains(std::exp(1.0) - 1));
+	check("verified e^x on [0, 1] width", growth.width(), 0, 1e-6);
+	Interval bell = integral_verified([](auto t){ return exp(-t * t); }, -3, 3);
+	check("verified e^-x^2 on [-3, 3] encloses sqrt(pi) erf(3)", bell.contains(std::sqrt(pi) * std::erf(3.0)));
+	//Not real on part of the range: nothing is known, so everything is possible.
+	Interval unreal = integral_verified([](auto t){ return sqrt(t); }, -1, 1);
+	check("verified sqrt on [-1, 1] is entire", std::isinf(unreal.lower()) && std::isinf(unreal.upper()));
+
+	std::printf("%d failed\n", failures);
+	return failures;
+}
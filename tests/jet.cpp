@@ -0,0 +1,41 @@
+//Taylor-mode automatic differentiation against derivatives with known values.
+
+#include "../include/Calculus.h"
+#include "check.h"
+
+using namespace calc;
+
+int main()
+{
+	//Every derivative of e^x is e^x.
+	std::array<double, 6> exponential = derivatives<5>([](auto x){ return exp(x); }, 1);
+	for(double d : exponential)
+	{
+		check("derivatives of e^x at 1", d, std::exp(1.0), 1e-14);
+	}
+	//1/(1 - x) = 1 + x + x^2 + ...
+	std::array<double, 9> geometric = taylor_coefficients<8>([](auto x){ return 1.0 / (1.0 - x); }, 0);
+	for(double c : geometric)
+	{
+		check("Taylor coefficients of 1/(1 - x) at 0", c, 1, 1e-15);
+	}
+	check("5th derivative of sin at 0", nth_derivative<5>([](auto x){ return sin(x); }, 0), 1, 1e-15);
+	check("3rd derivative of x^2.5 at 4", nth_derivative<3>([](auto x){ return pow(x, 2.5); }, 4), 2.5 * 1.5 * 0.5 / 2, 1e-14);
+	check("2nd derivative of atan at 1", nth_derivative<2>([](auto x){ return atan(x); }, 1), -0.5, 1e-15);
+	check("derivative of log(cosh x) at 0.5", nth_derivative<1>([](auto x){ return log(cosh(x)); }, 0.5), std::tanh(0.5), 1e-15);
+
+	//Comparisons look at the value, so a branchy function takes the branch doubles would.
+	auto clamp = [](auto x){ return x <= 1.0 ? x * x : 2.0 * x - 1.0; };
+	check("derivative of a branch below it", nth_derivative<1>(clamp, 0.5), 1, 0);
+	check("derivative of a branch above it", nth_derivative<1>(clamp, 2), 2, 0);
+	Jet<2> a = Jet<2>::variable(1);
+	Jet<2> b(1);
+	check("jets compare by value", a == b && a >= 1.0 && 1.0 <= b && !(a != b) && a != 2.0);
+
+	check("Newton root of x^2 - 2", roots_householder<1>([](auto x){ return x * x - 2.0; }, 1), std::sqrt(2.0), 1e-15);
+	check("Halley root of cos x - x", roots_householder<2>([](auto x){ return cos(x) - x; }, 1), 0.73908513321516064, 1e-15);
+	check("4th order root of e^x - 2", roots_householder<4>([](auto x){ return exp(x) - 2.0; }, 0), std::log(2.0), 1e-15);
+
+	std::printf("%d failed\n", failures);
+	return failures;
+}
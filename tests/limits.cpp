@@ -0,0 +1,51 @@
+//Limits at points and at infinity, including ones that don't exist.
+
+#include "../include/Calculus.h"
+#include "check.h"
+
+using namespace calc;
+
+int main()
+{
+	const double e = 2.71828182845904523536;
+	const double pi = 3.14159265358979323846;
+
+	check("sin(x) / x at 0", limit([](double x){ return std::sin(x) / x; }, 0).value, 1, 1e-10);
+	check("(1 - cos(x)) / x^2 at 0", limit([](double x){ return (1 - std::cos(x)) / (x * x); }, 0).value, 0.5, 1e-8);
+	check("x^2 at 3", limit([](double x){ return x * x; }, 3).value, 9, 1e-12);
+	check("(1 + 1/x)^x at inf", limit([](double x){ return std::pow(1 + 1 / x, x); }, INF).value, e, 1e-6);
+	check("atan(x) at -inf", limit([](double x){ return std::atan(x); }, -INF).value, -pi / 2, 1e-6);
+	check("e^-x at inf", limit([](double x){ return std::exp(-x); }, INF).value, 0, 1e-12);
+
+	//Only settles once x is well past 1e6.
+	check("x / (x + 1e6) at inf", limit([](double x){ return x / (x + 1e6); }, INF).value, 1, 1e-8);
+
+	//The error must cover how far a slowly converging limit still is.
+	Estimate root = limit([](double x){ return std::sqrt(x); }, 0, Side::Right);
+	check("sqrt(x) at 0+ error estimate", root.error >= std::abs(root.value));
+
+	//Unbounded growth comes back infinite, with an infinite error.
+	Estimate right = limit([](double x){ return 1 / x; }, 0, Side::Right);
+	check("1/x at 0+", right.value == INF && right.error == INF);
+	Estimate left = limit([](double x){ return 1 / x; }, 0, Side::Left);
+	check("1/x at 0-", left.value == -INF && left.error == INF);
+	Estimate square = limit([](double x){ return 1 / (x * x); }, 0);
+	check("1/x^2 at 0", square.value == INF && square.error == INF);
+	Estimate identity = limit([](double x){ return x; }, INF);
+	check("x at inf", identity.value == INF && identity.error == INF);
+	Estimate logarithm = limit([](double x){ return std::log(x); }, INF);
+	check("log(x) at inf", logarithm.value == INF && logarithm.error == INF);
+
+	//One-sided limits that disagree.
+	Estimate pole = limit([](double x){ return 1 / x; }, 0);
+	check("1/x at 0 doesn't exist", std::isnan(pole.value) && pole.error == INF);
+	Estimate step = limit([](double x){ return (x > 0) ? 1.0 : -1.0; }, 0);
+	check("sign(x) at 0 doesn't exist", std::isnan(step.value));
+
+	//No limit, and no confident answer.
+	Estimate sine = limit([](double x){ return std::sin(x); }, INF);
+	check("sin(x) at inf error estimate", sine.error > 1e-4);
+
+	std::printf("%d failed\n", failures);
+	return failures;
+}
@@ -0,0 +1,10 @@
+//Links with link_other.cpp, which includes the header too, so anything defined in it that isn't inline is defined twice.
+
+#include "../include/Calculus.h"
+
+int other();
+
+int main()
+{
+	return other();
+}
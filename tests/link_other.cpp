@@ -0,0 +1,8 @@
+//The second translation unit of the link test.
+
+#include "../include/Calculus.h"
+
+int other()
+{
+	return 0;
+}
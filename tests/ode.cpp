@@ -0,0 +1,84 @@
+//Every explicit Runge-Kutta method against ODEs with known solutions.
+
+#include "../include/Calculus.h"
+#include "check.h"
+
+#include <string>
+
+using namespace calc;
+
+typedef std::array<double, 2> Vec2;
+
+int main()
+{
+	const RungeKutta methods[] = {RungeKutta::RK4, RungeKutta::DormandPrince, RungeKutta::Verner65,
+								  RungeKutta::PrinceDormand87, RungeKutta::DOP853};
+	const char *names[] = {"RK4", "DormandPrince", "Verner65", "PrinceDormand87", "DOP853"};
+	auto decay = [](double, double y){ return -y; };
+	auto oscillator = [](double, const Vec2 &y){ return Vec2{y[1], -y[0]}; };
+	std::vector<double> times;
+	for(int k = 1; k <= 200; ++k)
+	{
+		times.push_back(0.0937 * k);
+	}
+
+	for(int m = 0; m < 5; ++m)
+	{
+		Options opts;
+		opts.ode = methods[m];
+		opts.rel_tol = opts.abs_tol = 1e-10;
+		opts.step = 1e-3;
+		const std::string name = names[m];
+		const bool adaptive = methods[m] != RungeKutta::RK4;
+
+		//y' = -y, whose error estimate must neither vanish nor fall short of the error.
+		BasicEstimate<double> exponential = ode_solve<double>(decay, 0, 1, 5, opts);
+		const double error = std::abs(exponential.value - std::exp(-5.0));
+		check((name + " y' = -y").c_str(), exponential.value, std::exp(-5.0), 1e-9);
+		if(adaptive)
+		{
+			check((name + " y' = -y error estimate").c_str(), exponential.error > 0 && exponential.error >= error);
+		}
+
+		BasicEstimate<Vec2> harmonic = ode_solve<Vec2>(oscillator, 0, Vec2{1, 0}, 20, opts);
+		check((name + " y'' = -y").c_str(), harmonic.value[0], std::cos(20.0), 1e-8);
+
+		//Dense output in between the steps.
+		std::vector<Vec2> dense = ode_solve_at<Vec2>(oscillator, 0, Vec2{1, 0}, times, opts);
+		double worst = 0;
+		for(std::size_t k = 0; k < times.size(); ++k)
+		{
+			worst = std::max(worst, std::abs(dense[k][0] - std::cos(times[k])));
+		}
+		check((name + " y'' = -y interpolated").c_str(), worst, 0, 1e-8);
+
+		//A batch of oscillators, y0 = 1 + i / 100, comes out as each would alone.
+		const std::size_t count = 100;
+		std::vector<double> y0(2 * count, 0);
+		for(std::size_t i = 0; i < count; ++i)
+		{
+			y0[i] = 1 + 0.01 * i;
+		}
+		BasicEstimate<std::vector<double>> batch = ode_solve_batch<double>(
+			[](const std::vector<double> &, const std::vector<double> &y, std::vector<double> &dydt){
+				const std::size_t n = y.size() / 2;
+				for(std::size_t i = 0; i < n; ++i)
+				{
+					dydt[i] = y[n + i];
+					dydt[n + i] = -y[i];
+				}
+			}, 0, y0, count, 20, opts);
+		worst = 0;
+		for(std::size_t i = 0; i < count; ++i)
+		{
+			worst = std::max(worst, std::abs(batch.value[i] - y0[i] * std::cos(20.0)));
+		}
+		check((name + " batch y'' = -y").c_str(), worst, 0, 1e-8);
+		//Same initial step and controller, so the same steps as a solution on its own.
+		BasicEstimate<Vec2> alone = ode_solve<Vec2>(oscillator, 0, Vec2{y0[count - 1], 0}, 20, opts);
+		check((name + " batch matches ode_solve").c_str(), batch.value[count - 1], alone.value[0], 1e-12);
+	}
+
+	std::printf("%d failed\n", failures);
+	return failures;
+}
@@ -0,0 +1,88 @@
+//The defaults and presets of Options, the threads the parallel algorithms run on, and that their amount doesn't change any result.
+
+#include "../include/Calculus.h"
+#include "check.h"
+
+#include <atomic>
+
+using namespace calc;
+
+int main()
+{
+	Options defaults;
+	check("threads default to 1", defaults.threads == 1);
+	check("precise() tightens rel_tol", Options::precise().rel_tol < defaults.rel_tol);
+	check("precise() doesn't round", Options::precise().digits < 0);
+	check("fast() loosens rel_tol", Options::fast().rel_tol > defaults.rel_tol);
+	check("fast() lowers max_evaluations", Options::fast().max_evaluations < defaults.max_evaluations);
+
+	//By default the functions are never called from more than one thread.
+	std::atomic<int> inside(0);
+	std::atomic<int> most(0);
+	auto guarded = [&](const std::vector<double> &x){
+		int now = ++inside;
+		int seen = most;
+		while(now > seen && !most.compare_exchange_weak(seen, now))
+		{
+		}
+		double value = std::exp(x[0] * x[1]);
+		--inside;
+		return value;
+	};
+	integral_cubature(guarded, {0, 0}, {1, 1});
+	check("cubature calls on one thread by default", most == 1);
+
+	//The same results for any amount of threads.
+	Options parallel;
+	parallel.threads = 4;
+	auto product = [](const std::vector<double> &x){ return std::exp(x[0] * x[1]); };
+	check("cubature on 4 threads", integral_cubature(product, {0, 0}, {1, 1}, parallel).value,
+		  integral_cubature(product, {0, 0}, {1, 1}).value, 1e-12);
+	auto sum = [](const std::vector<double> &x){ return x[0] + x[1] + x[2]; };
+	const std::vector<double> lower(3, 0);
+	const std::vector<double> upper(3, 1);
+	check("QMC on 4 threads is bit-for-bit the same",
+		  integral_qmc(sum, lower, upper, 1 << 12, 8, Sequence::Sobol, 1, parallel).value ==
+		  integral_qmc(sum, lower, upper, 1 << 12, 8, Sequence::Sobol).value);
+
+	//The pool keeps its threads between loops, and a loop nested in one of its own runs on threads of its own.
+	detail::ThreadPool pool(4);
+	std::vector<std::atomic<int>> counts(64);
+	for(int round = 0; round < 3; ++round)
+	{
+		detail::parallel_for(counts.size(), 4, [&](std::size_t i){
+			detail::parallel_for(counts.size(), 4, [&](std::size_t j){
+				++counts[(i + j) % counts.size()];
+			}, &pool);
+		}, &pool);
+	}
+	bool every = true;
+	for(const std::atomic<int> &count : counts)
+	{
+		every = every && count == 3 * 64;
+	}
+	check("nested parallel loops on one pool", every);
+	bool declined = false;
+	pool.run(1, 4, [&](std::size_t){
+		declined = !pool.run(1, 4, [](std::size_t){});
+	});
+	check("a busy pool declines", declined);
+	bool rethrown = false;
+	try
+	{
+		detail::parallel_for(100, 4, [](std::size_t i){
+			if(i == 50)
+			{
+				throw std::domain_error("fifty");
+			}
+		}, &pool);
+	}
+	catch(const std::domain_error &)
+	{
+		rethrown = true;
+	}
+	check("the pool rethrows", rethrown);
+
+	std::printf("%d failed\n", failures);
+	return failures;
+}
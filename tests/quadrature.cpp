@@ -0,0 +1,108 @@
+//Every quadrature rule against integrals with known values.
+
+#include "../include/Calculus.h"
+#include "check.h"
+
+using namespace calc;
+
+int main()
+{
+	const double pi = 3.14159265358979323846;
+	const double e = 2.71828182845904523536;
+	Options exact;
+	exact.digits = -1;
+	Options four;
+	four.threads = 4;
+
+	Options riemann = exact;
+	riemann.quadrature = Quadrature::Riemann;
+	check("Riemann x^2 on [0, 1]", integral_definite([](double x){ return x * x; }, 0, 1, riemann), 1.0 / 3, 1e-3);
+
+	Options tanhSinh = exact;
+	tanhSinh.quadrature = Quadrature::TanhSinh;
+	check("TanhSinh x^2 on [0, 1]", integral_definite([](double x){ return x * x; }, 0, 1, tanhSinh), 1.0 / 3, 1e-12);
+
+	//The end-point singularities, and that the error estimate covers the error.
+	Estimate arcsine = integral_tanh_sinh([](double x){ return 1 / std::sqrt(1 - x * x); }, -1, 1, Options::precise());
+	check("tanh-sinh 1/sqrt(1 - x^2) on [-1, 1]", arcsine.value, pi, 1e-7);
+	check("tanh-sinh 1/sqrt(1 - x^2) error estimate", arcsine.error >= std::abs(arcsine.value - pi));
+	Estimate log = integral_tanh_sinh([](double x){ return std::log(x); }, 0, 1);
+	check("tanh-sinh log(x) on [0, 1]", log.value, -1, 1e-10);
+	check("tanh-sinh log(x) error estimate", log.error >= std::abs(log.value + 1));
+
+	check("exp-sinh e^-x on [0, inf)", integral_exp_sinh([](double x){ return std::exp(-x); }, 0).value, 1, 1e-10);
+	check("exp-sinh 1/(1 + x^2) on [0, inf)", integral_exp_sinh([](double x){ return 1 / (1 + x * x); }, 0).value, pi / 2, 1e-8);
+	check("sinh-sinh e^-x^2", integral_sinh_sinh([](double x){ return std::exp(-x * x); }).value, std::sqrt(pi), 1e-10);
+	check("improper 1/x^2 on [1, inf)", integral_improper([](double x){ return 1 / (x * x); }, 1, INF).value, 1, 1e-10);
+	check("improper 1/(1 + x^2) on (-inf, inf)", integral_improper([](double x){ return 1 / (1 + x * x); }, -INF, INF).value, pi, 1e-8);
+
+	//Exact for polynomials up to degree 2N - 1.
+	check("Gauss 5 x^9 on [0, 1]", integral_gauss<5>([](double x){ return std::pow(x, 9); }, 0, 1), 0.1, 1e-15);
+	check("Gauss 5 sin on [0, pi], 4 panels", integral_gauss<5>([](double x){ return std::sin(x); }, 0, pi, 4), 2, 1e-10);
+
+	//Lobatto keeps the end-points and is exact up to degree 2N - 3.
+	constexpr QuadratureRule<5> lobatto = gauss_lobatto<5>();
+	check("Lobatto 5 end-points", lobatto.nodes[0] == -1 && lobatto.nodes[4] == 1);
+	double lobattoSum = 0;
+	for(std::size_t i = 0; i < 5; ++i)
+	{
+		lobattoSum += lobatto.weights[i] * std::pow(lobatto.nodes[i], 6);
+	}
+	check("Lobatto 5 x^6 on [-1, 1]", lobattoSum, 2.0 / 7, 1e-15);
+
+	auto product = [](const std::vector<double> &x){ return x[0] * x[1] * x[2]; };
+	check("cubature xyz on [0, 1]^3", integral_cubature(product, {0, 0, 0}, {1, 1, 1}).value, 0.125, 1e-12);
+	auto exponential = [](const std::vector<double> &x){ return std::exp(x[0] + x[1]); };
+	Estimate serial = integral_cubature(exponential, {0, 0}, {1, 1});
+	check("cubature e^(x + y) on [0, 1]^2", serial.value, (e - 1) * (e - 1), 1e-6);
+	check("cubature on 4 threads matches 1", integral_cubature(exponential, {0, 0}, {1, 1}, four).value == serial.value);
+	bool rethrown = false;
+	try
+	{
+		integral_cubature([](const std::vector<double> &x)->double{
+			if(x[0] > 0.9)
+			{
+				throw std::domain_error("outside");
+			}
+			return 1;
+		}, {0, 0}, {1, 1}, four);
+	}
+	catch(const std::domain_error &)
+	{
+		rethrown = true;
+	}
+	check("cubature passes exceptions on", rethrown);
+
+	auto sum = [](const std::vector<double> &x){
+		double total = 0;
+		for(double v : x)
+		{
+			total += v;
+		}
+		return total;
+	};
+	const std::vector<double> lower(5, 0);
+	const std::vector<double> upper(5, 1);
+	Estimate sobol = integral_qmc(sum, lower, upper, 1 << 12, 8, Sequence::Sobol);
+	check("Sobol QMC sum on [0, 1]^5", sobol.value, 2.5, 1e-3);
+	check("Halton QMC sum on [0, 1]^5", integral_qmc(sum, lower, upper, 1 << 12, 8, Sequence::Halton).value, 2.5, 1e-3);
+	check("Sobol QMC on 4 threads matches 1", integral_qmc(sum, lower, upper, 1 << 12, 8, Sequence::Sobol, 1, four).value == sobol.value);
+	bool thrown = false;
+	try
+	{
+		integral_qmc(sum, lower, upper, 0);
+	}
+	catch(const std::invalid_argument &)
+	{
+		thrown = true;
+	}
+	check("QMC with no points throws", thrown);
+	//Past SobolSequence::MAX_DIMENSION, Sobol is Halton.
+	const std::vector<double> wide(SobolSequence::MAX_DIMENSION + 1, 1);
+	const std::vector<double> origin(wide.size(), 0);
+	check("Sobol QMC falls back to Halton", integral_qmc(sum, origin, wide, 1 << 10, 4, Sequence::Sobol).value ==
+		  integral_qmc(sum, origin, wide, 1 << 10, 4, Sequence::Halton).value);
+
+	std::printf("%d failed\n", failures);
+	return failures;
+}
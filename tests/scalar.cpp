@@ -0,0 +1,53 @@
+//The templated algorithms with float, long double and (with CALC_FLOAT128) __float128, each to the precision of its type.
+
+#include "../include/Calculus.h"
+#include "check.h"
+
+#include <string>
+
+using namespace calc;
+
+//Everything each scalar type goes through, with tolerances scaled by that type's epsilon.
+template<typename T>
+void scalar(const std::string &type)
+{
+	const double eps = double(detail::epsilon<T>());
+	const T pi = T(4) * detail::atan(T(1));
+	auto name = [&](const char *what){ return type + " " + what; };
+
+	BasicOptions<T> opts;
+	check(name("rel_tol scales with epsilon").c_str(), double(opts.rel_tol), std::sqrt(eps), 1e-3 * std::sqrt(eps));
+
+	BasicEstimate<T> derivative = derivative_estimate<T>([](T x){ return detail::exp(x); }, 1);
+	check(name("Richardson e^x at 1").c_str(), double(derivative.value / detail::exp(T(1))), 1, 1e3 * eps);
+
+	BasicEstimate<T> quadrature = integral_tanh_sinh<T>([](T x){ return 1 / detail::sqrt(1 - x * x); }, -1, 1, BasicOptions<T>::precise());
+	check(name("tanh-sinh 1/sqrt(1 - x^2)").c_str(), double((quadrature.value - pi) / pi), 0, std::max(1e4 * eps, 1e-7));
+
+	check(name("Gauss 8 x^15 on [0, 1]").c_str(), double(integral_gauss<8, T>([](T x){ return detail::pow(x, T(15)); }, 0, 1) * 16), 1, 100 * eps);
+
+	BasicEstimate<T> series = sum_series<T>([](std::size_t n){ return ((n % 2) ? (T(-1)) : (T(1))) / (2 * T(n) + 1); });
+	check(name("Levin 1 - 1/3 + 1/5 - ...").c_str(), double((series.value - pi / 4) / pi), 0, std::max(1e4 * eps, 1e-9));
+
+	BasicEstimate<T> root = sum_series<T>([](std::size_t n){ return 1 / detail::sqrt(T(n)); }, Acceleration::Levin, 1);
+	check(name("Levin 1/sqrt(n) diverges").c_str(), detail::isinf(root.value) && detail::isinf(root.error));
+
+	BasicEstimate<T> lim = limit<T>([](T x){ return detail::sin(x) / x; }, 0);
+	check(name("sin(x) / x at 0").c_str(), double(lim.value), 1, std::max(100 * std::sqrt(eps), 1e-9));
+
+	check(name("Halley root of x^2 - 2").c_str(), double(roots_householder<2, T>([](auto x){ return x * x - T(2); }, 1) / detail::sqrt(T(2))), 1, 4 * eps);
+	check(name("5th derivative of e^x at 0").c_str(), double(nth_derivative<5, T>([](auto x){ return exp(x); }, 0)), 1, 10 * eps);
+}
+
+int main()
+{
+	scalar<float>("float");
+	scalar<double>("double");
+	scalar<long double>("long double");
+#if defined(CALC_FLOAT128)
+	scalar<__float128>("__float128");
+#endif
+
+	std::printf("%d failed\n", failures);
+	return failures;
+}
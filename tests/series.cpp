@@ -0,0 +1,47 @@
+//Every series acceleration against sums with known values, and divergent series that must not get one.
+
+#include "../include/Calculus.h"
+#include "check.h"
+
+#include <string>
+
+using namespace calc;
+
+int main()
+{
+	const double pi = 3.14159265358979323846;
+	auto alternating = [](std::size_t n){ return ((n % 2) ? (-1.0) : (1.0)) / (n + 1); };
+	auto geometric = [](std::size_t n){ return std::pow(0.5, double(n)); };
+	auto basel = [](std::size_t n){ return 1 / (double(n) * n); };
+
+	//Each method on the kind of series it's meant for.
+	check("None 2^-n", sum_series(geometric, Acceleration::None).value, 2, 1e-7);
+	check("Richardson 1/n^2", sum_series(basel, Acceleration::Richardson, 1).value, pi * pi / 6, 1e-8);
+	check("Euler (-1)^n / (n + 1)", sum_series(alternating, Acceleration::Euler).value, std::log(2.0), 1e-8);
+	check("Wynn (-1)^n / (n + 1)", sum_series(alternating, Acceleration::Wynn).value, std::log(2.0), 1e-8);
+	check("Wynn 2^-n", sum_series(geometric, Acceleration::Wynn).value, 2, 1e-12);
+	check("Levin 1/n^2", sum_series(basel, Acceleration::Levin, 1).value, pi * pi / 6, 1e-8);
+	check("Levin (-1)^n / (n + 1)", sum_series(alternating, Acceleration::Levin).value, std::log(2.0), 1e-8);
+	check("Levin (-10)^n / n!", sum_series([](std::size_t n){ return std::pow(-10.0, double(n)) / std::tgamma(n + 1.0); }).value,
+		  std::exp(-10.0), 1e-10);
+
+	//Divergent series, which every method must report as such.
+	const Acceleration methods[] = {Acceleration::None, Acceleration::Richardson, Acceleration::Euler, Acceleration::Wynn,
+									Acceleration::Levin};
+	const char *names[] = {"None", "Richardson", "Euler", "Wynn", "Levin"};
+	for(int m = 0; m < 5; ++m)
+	{
+		const std::string name = names[m];
+		Estimate root = sum_series([](std::size_t n){ return 1 / std::sqrt(double(n)); }, methods[m], 1);
+		check((name + " 1/sqrt(n) diverges").c_str(), root.value == INF && root.error == INF);
+		Estimate linear = sum_series([](std::size_t n){ return double(n); }, methods[m], 1);
+		check((name + " n diverges").c_str(), linear.value == INF && linear.error == INF);
+		Estimate harmonic = sum_series([](std::size_t n){ return -1.0 / n; }, methods[m], 1);
+		check((name + " -1/n diverges").c_str(), harmonic.value == -INF && harmonic.error == INF);
+	}
+	Estimate signs = sum_series([](std::size_t n){ return (n % 2) ? (-1.0) : (1.0); }, Acceleration::Levin);
+	check("Levin (-1)^n diverges", std::isnan(signs.value) && signs.error == INF);
+
+	std::printf("%d failed\n", failures);
+	return failures;
+}
@@ -0,0 +1,67 @@
+//Every stiff method against ODEs with known solutions.
+
+#include "../include/Calculus.h"
+#include "check.h"
+
+#include <string>
+
+using namespace calc;
+
+typedef std::array<double, 2> Vec2;
+typedef std::array<double, 3> Vec3;
+
+int main()
+{
+	const Stiff methods[] = {Stiff::ROS34PW2, Stiff::Rodas4, Stiff::BDF};
+	const char *names[] = {"ROS34PW2", "Rodas4", "BDF"};
+	auto decay = [](double, double y){ return -y; };
+	//y = cos(t) + e^(-10000 t).
+	auto forced = [](double t, double y){ return -1e4 * (y - std::cos(t)) - std::sin(t); };
+	//y = (e^-t + e^(-10000 t), e^-t).
+	auto linear = [](double, const Vec2 &y){ return Vec2{-1e4 * y[0] + (1e4 - 1) * y[1], -y[1]}; };
+	//Robertson's reactions, with the solution at t = 40 from Hairer & Wanner's test set.
+	auto robertson = [](double, const Vec3 &y){
+		return Vec3{-0.04 * y[0] + 1e4 * y[1] * y[2], 0.04 * y[0] - 1e4 * y[1] * y[2] - 3e7 * y[1] * y[1], 3e7 * y[1] * y[1]};
+	};
+	const Vec3 reference = {0.7158270687193941, 9.185534764529502e-06, 0.2841637457458413};
+	std::vector<double> times;
+	for(int k = 1; k <= 100; ++k)
+	{
+		times.push_back(0.1 * k);
+	}
+
+	for(int m = 0; m < 3; ++m)
+	{
+		Options opts;
+		opts.stiff = methods[m];
+		opts.rel_tol = opts.abs_tol = 1e-7;
+		const std::string name = names[m];
+
+		//y' = -y, whose error estimate must neither vanish nor fall short of the error.
+		BasicEstimate<double> exponential = stiff_solve<double>(decay, 0, 1, 5, opts);
+		const double error = std::abs(exponential.value - std::exp(-5.0));
+		check((name + " y' = -y").c_str(), exponential.value, std::exp(-5.0), 1e-6);
+		check((name + " y' = -y error estimate").c_str(), exponential.error > 0 && exponential.error >= error);
+
+		check((name + " forced").c_str(), stiff_solve<double>(forced, 0, 2, 10, opts).value, std::cos(10.0), 1e-6);
+		check((name + " linear").c_str(), stiff_solve<Vec2>(linear, 0, Vec2{2, 1}, 10, opts).value[0], std::exp(-10.0), 1e-6);
+		std::vector<Vec2> dense = stiff_solve_at<Vec2>(linear, 0, Vec2{2, 1}, times, opts);
+		double worst = 0;
+		for(std::size_t k = 0; k < times.size(); ++k)
+		{
+			worst = std::max(worst, std::abs(dense[k][0] - std::exp(-times[k]) - std::exp(-1e4 * times[k])));
+		}
+		check((name + " linear interpolated").c_str(), worst, 0, 1e-5);
+
+		Options tight = opts;
+		tight.rel_tol = 1e-8;
+		tight.abs_tol = 1e-14;
+		BasicEstimate<Vec3> reactions = stiff_solve<Vec3>(robertson, 0, Vec3{1, 0, 0}, 40, tight);
+		check((name + " Robertson y1").c_str(), reactions.value[0], reference[0], 1e-6);
+		check((name + " Robertson y2").c_str(), reactions.value[1], reference[1], 1e-11);
+		check((name + " Robertson y3").c_str(), reactions.value[2], reference[2], 1e-6);
+	}
+
+	std::printf("%d failed\n", failures);
+	return failures;
+}
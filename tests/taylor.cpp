@@ -0,0 +1,48 @@
+//Taylor polynomials and their evaluation schemes against known series.
+
+#include "../include/Calculus.h"
+#include "check.h"
+
+using namespace calc;
+
+int main()
+{
+	//e^x around 1: every coefficient is e/k!.
+	Polynomial exponential = taylor<12>([](auto x){ return exp(x); }, 1);
+	check("Taylor degree", exponential.degree() == 12);
+	double factorial = 1;
+	for(std::size_t k = 0; k <= 12; ++k)
+	{
+		factorial *= k ? k : 1;
+		check("Taylor coefficients of e^x at 1", exponential.coefficients()[k] * factorial, std::exp(1.0), 1e-13);
+	}
+	check("Estrin e^x at 1.5", exponential(1.5), std::exp(1.5), 1e-12);
+	check("Estrin matches Horner", exponential(0.25), exponential.horner(0.25), 1e-14);
+
+	//The batch gives the same values as one point at a time.
+	std::vector<double> xs, out;
+	for(int i = 0; i <= 100; ++i)
+	{
+		xs.push_back(0.5 + i * 0.01);
+	}
+	exponential.evaluate(xs, out);
+	bool same = out.size() == xs.size();
+	for(std::size_t i = 0; same && i < xs.size(); ++i)
+	{
+		same = std::abs(out[i] - exponential.horner(xs[i])) <= 1e-14 * out[i];
+	}
+	check("batched evaluation matches Horner", same);
+
+	//Cauchy's integral formula from complex samples.
+	Polynomial cauchy = taylor([](std::complex<double> z){ return std::exp(z); }, 0, 10);
+	check("Cauchy Taylor e^x 4th coefficient", cauchy.coefficients()[4], 1.0 / 24, 1e-14);
+	check("Cauchy Taylor e^x at 0.5", cauchy(0.5), std::exp(0.5), 1e-10);
+
+	//1/(1 + x^2) has poles at +-i, so the radius around 0 is 1, around 1 it's sqrt(2).
+	auto runge = [](auto x){ return 1.0 / (1.0 + x * x); };
+	check("radius of convergence of 1/(1 + x^2) at 0", taylor<30>(runge, 0).radius_of_convergence(), 1, 0.05);
+	check("radius of convergence of 1/(1 + x^2) at 1", taylor<30>(runge, 1).radius_of_convergence(), std::sqrt(2.0), 0.1);
+
+	std::printf("%d failed\n", failures);
+	return failures;
+}